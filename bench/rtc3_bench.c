@@ -0,0 +1,480 @@
+/*
+    rtc3_bench.c
+
+-----------------------------------------------------------------------------
+
+  This file is part of mikroSDK.
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+----------------------------------------------------------------------------- */
+
+/**
+@file   rtc3_bench.c
+@brief    RTC 3 Click host benchmark
+*/
+/**
+@defgroup   RTC3_BENCH
+@brief      Per call cost of the driver API against the BQ32000 simulator
+@{
+
+Every API call is run many times on the host, linked against the BQ32000
+model ( __rtc3_sim.c ) with the HAL bus statistics enabled. For each call
+one CSV row is printed to stdout :
+
+- api : driver function;
+- ns_per_call : host time per call, best of several rounds, including the
+  simulated bus;
+- transactions_per_call : completed START ... STOP transactions;
+- bytes_per_call : bytes on the bus, address bytes included;
+- bus_us_100khz, bus_us_400khz : worst case wire time of one call, as
+  modelled by the simulator at 100 kHz and 400 kHz SCL with the given
+  clock stretch per byte;
+- syscalls_per_call : I2C_RDWR ioctls issued by the Linux i2c-dev HAL,
+  built with __HAL_LINUX__ against rtc3sim_i2cdevIoctl, 0 for the
+  host HAL;
+- cycles_per_call : time stamp counter ticks per call in the best round
+  on x86, ns elsewhere.
+
+All of these are host figures. The bench does not run on, or model the
+cycle cost of, the 8-bit PIC and AVR targets.
+
+Build and run from the repository root :
+
+    make -C bench run
+    make -C bench run-linux
+    make -C bench run-static
+
+or without make :
+
+    gcc -O2 -D__HAL_HOST__ -D__HAL_STATS__ -Ilibrary bench/rtc3_bench.c \
+        library/__rtc3_driver.c library/__rtc3_sim.c -o rtc3_bench
+    ./rtc3_bench [calls] [stretch_ns]
+
+*/
+/* -------------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#if defined( __x86_64__ ) || defined( __i386__ )
+#include <x86intrin.h>
+#endif
+
+#include "__rtc3_driver.h"
+#include "__rtc3_sim.h"
+
+/* ------------------------------------------------------------------- MACROS */
+
+#define _BENCH_CALLS_DEFAULT                                              20000UL
+#define _BENCH_ROUNDS                                                     5
+
+/* ----------------------------------------------------------------- VARIABLES */
+
+typedef void (*bench_fn_t)();
+
+typedef struct
+{
+    const char  *name;
+    bench_fn_t  fn;
+
+}bench_case_t;
+
+static rtc3_datetime_t  _dateTime = { 56, 34, 12, 3, 15, 5, 2024 };
+static rtc3_snapshot_t  _snapshot;
+static char             _text[ 40 ];
+static volatile uint32_t _sink;
+static uint32_t         _syscalls;
+
+#ifdef __HAL_LINUX__
+static int _ioctl( int fd, unsigned long request, void *arg )
+{
+    _syscalls++;
+
+    return rtc3sim_i2cdevIoctl( fd, request, arg );
+}
+
+static const rtc3_linuxI2c_t _bus = { -1, _ioctl };
+#endif
+
+/* ------------------------------------------------------------ BENCH CASES */
+
+static void _getTime()
+{
+    uint8_t h, m, s;
+
+    rtc3_getTime( &h, &m, &s );
+    _sink += s;
+}
+
+static void _getDate()
+{
+    uint8_t w, d, m;
+    uint16_t y;
+
+    rtc3_getDate( &w, &d, &m, &y );
+    _sink += d;
+}
+
+static void _getDateTime()
+{
+    rtc3_datetime_t dt;
+
+    rtc3_getDateTime( &dt );
+    _sink += dt.timeSeconds;
+}
+
+static void _pollChanged()
+{
+    rtc3_datetime_t dt;
+
+    _sink += rtc3_pollChanged( &dt );
+}
+
+static void _getEpoch()
+{
+    _sink += rtc3_getEpoch();
+}
+
+static void _getSnapshot()
+{
+    rtc3_getSnapshot( &_snapshot );
+}
+
+static void _getTimeSeconds()
+{
+    _sink += rtc3_getTimeSeconds();
+}
+
+static void _getDateYear()
+{
+    _sink += rtc3_getDateYear();
+}
+
+static void _getInterrupt()
+{
+    _sink += rtc3_getInterrupt();
+}
+
+static void _readByte()
+{
+    _sink += rtc3_readByte( _RTC3_REG_CONFIG1 );
+}
+
+static void _setTime()
+{
+    rtc3_setTime( 12, 34, 56 );
+}
+
+static void _setDate()
+{
+    rtc3_setDate( 3, 15, 5, 2024 );
+}
+
+static void _setDateTime()
+{
+    rtc3_setDateTime( &_dateTime );
+}
+
+static void _setEpoch()
+{
+    rtc3_setEpoch( 1715776496UL );
+}
+
+static void _setTimeSeconds()
+{
+    rtc3_setTimeSeconds( 56 );
+}
+
+static void _setTimeMinutes()
+{
+    rtc3_setTimeMinutes( 34 );
+}
+
+static void _setTimeHours()
+{
+    rtc3_setTimeHours( 12 );
+}
+
+static void _setDateDay()
+{
+    rtc3_setDateDay( 15 );
+}
+
+static void _setDateMonth()
+{
+    rtc3_setDateMonth( 5 );
+}
+
+static void _setDateYear()
+{
+    rtc3_setDateYear( 2024 );
+}
+
+static void _setCalibration()
+{
+    rtc3_setCalibration( 0, 5 );
+}
+
+static void _setFrequencyCalibration()
+{
+    rtc3_setFrequencyCalibration( 1 );
+}
+
+static void _dateTimeToEpoch()
+{
+    _sink += rtc3_dateTimeToEpoch( &_dateTime );
+}
+
+static void _epochToDateTime()
+{
+    rtc3_datetime_t dt;
+
+    rtc3_epochToDateTime( 1715776496UL + _sink % 7, &dt );
+    _sink += dt.timeSeconds;
+}
+
+static void _decodeSnapshot()
+{
+    rtc3_datetime_t dt;
+
+    rtc3_decodeSnapshot( &_snapshot, &dt );
+    _sink += dt.timeSeconds;
+}
+
+static void _formatIso8601()
+{
+    _sink += rtc3_formatIso8601( &_snapshot, _text );
+}
+
+static void _formatCustom()
+{
+    _sink += rtc3_formatCustom( &_snapshot, "%a %d.%m.%Y %H:%M:%S", _text, sizeof( _text ) );
+}
+
+static const bench_case_t _cases[] =
+{
+    { "rtc3_getTime",                   _getTime },
+    { "rtc3_getDate",                   _getDate },
+    { "rtc3_getDateTime",               _getDateTime },
+    { "rtc3_pollChanged",               _pollChanged },
+    { "rtc3_getEpoch",                  _getEpoch },
+    { "rtc3_getSnapshot",               _getSnapshot },
+    { "rtc3_getTimeSeconds",            _getTimeSeconds },
+    { "rtc3_getDateYear",               _getDateYear },
+    { "rtc3_getInterrupt",              _getInterrupt },
+    { "rtc3_readByte",                  _readByte },
+    { "rtc3_setTime",                   _setTime },
+    { "rtc3_setDate",                   _setDate },
+    { "rtc3_setDateTime",               _setDateTime },
+    { "rtc3_setEpoch",                  _setEpoch },
+    { "rtc3_setTimeSeconds",            _setTimeSeconds },
+    { "rtc3_setTimeMinutes",            _setTimeMinutes },
+    { "rtc3_setTimeHours",              _setTimeHours },
+    { "rtc3_setDateDay",                _setDateDay },
+    { "rtc3_setDateMonth",              _setDateMonth },
+    { "rtc3_setDateYear",               _setDateYear },
+    { "rtc3_setCalibration",            _setCalibration },
+    { "rtc3_setFrequencyCalibration",   _setFrequencyCalibration },
+    { "rtc3_dateTimeToEpoch",           _dateTimeToEpoch },
+    { "rtc3_epochToDateTime",           _epochToDateTime },
+    { "rtc3_decodeSnapshot",            _decodeSnapshot },
+    { "rtc3_formatIso8601",             _formatIso8601 },
+    { "rtc3_formatCustom",              _formatCustom }
+};
+
+/* ----------------------------------------------------------- PRIVATE FUNCTIONS */
+
+static uint64_t _nowNs()
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t _nowCycles()
+{
+#if defined( __x86_64__ ) || defined( __i386__ )
+    return __rdtsc();
+#else
+    return _nowNs();
+#endif
+}
+
+static uint32_t _busWorstNs( const bench_case_t *bc, uint32_t calls, uint32_t sclHz, uint32_t stretchNs )
+{
+    uint64_t stamp;
+    uint32_t elapsed;
+    uint32_t worst;
+    uint32_t i;
+
+    rtc3sim_setBusTiming( sclHz, stretchNs );
+    worst = 0;
+
+    // Simulated time moves only while the master is on the bus
+    for ( i = 0; i < calls; i++ )
+    {
+        stamp = rtc3sim_getTime();
+        bc->fn();
+        elapsed = (uint32_t)( rtc3sim_getTime() - stamp );
+
+        if ( elapsed > worst )
+        {
+            worst = elapsed;
+        }
+    }
+
+    return worst;
+}
+
+static void _run( const bench_case_t *bc, uint32_t calls, uint32_t stretchNs )
+{
+    rtc3_stats_t stats;
+    uint64_t best;
+    uint64_t elapsed;
+    uint64_t bestCycles;
+    uint64_t cycles;
+    uint32_t bus100;
+    uint32_t bus400;
+    uint32_t syscalls;
+    uint32_t i;
+    uint8_t round;
+
+    best = 0;
+    bestCycles = 0;
+    rtc3sim_setBusTiming( 100000UL, stretchNs );
+
+    for ( round = 0; round < _BENCH_ROUNDS; round++ )
+    {
+        rtc3_resetStats();
+        _syscalls = 0;
+        elapsed = _nowNs();
+        cycles = _nowCycles();
+
+        for ( i = 0; i < calls; i++ )
+        {
+            bc->fn();
+        }
+
+        cycles = _nowCycles() - cycles;
+        elapsed = _nowNs() - elapsed;
+
+        if ( round == 0 || elapsed < best )
+        {
+            best = elapsed;
+        }
+
+        if ( round == 0 || cycles < bestCycles )
+        {
+            bestCycles = cycles;
+        }
+    }
+
+    // Statistics of the last round, every round does the same work
+    rtc3_getStats( &stats );
+    syscalls = _syscalls;
+
+    bus100 = _busWorstNs( bc, calls, 100000UL, stretchNs );
+    bus400 = _busWorstNs( bc, calls, 400000UL, stretchNs );
+
+    printf( "%s,%.1f,%.2f,%.2f,%.1f,%.1f,%.2f,%.0f\n",
+            bc->name,
+            (double)best / calls,
+            (double)stats.transactions / calls,
+            (double)( stats.bytesWritten + stats.bytesRead ) / calls,
+            bus100 / 1000.0,
+            bus400 / 1000.0,
+            (double)syscalls / calls,
+            (double)bestCycles / calls );
+}
+
+/* --------------------------------------------------------------------- MAIN */
+
+int main( int argc, char **argv )
+{
+    uint32_t calls;
+    uint32_t stretchNs;
+    uint8_t i;
+
+    calls = _BENCH_CALLS_DEFAULT;
+    stretchNs = 0;
+
+    if ( argc > 1 )
+    {
+        calls = (uint32_t)strtoul( argv[ 1 ], 0, 0 );
+
+        if ( calls == 0 )
+        {
+            fprintf( stderr, "usage: %s [calls] [stretch_ns]\n", argv[ 0 ] );
+            return 1;
+        }
+    }
+
+    if ( argc > 2 )
+    {
+        stretchNs = (uint32_t)strtoul( argv[ 2 ], 0, 0 );
+    }
+
+    rtc3sim_reset();
+#ifdef __HAL_LINUX__
+    rtc3_i2cDriverInit( (T_RTC3_P)&_HOST_MIKROBUS_GPIO, (T_RTC3_P)&_bus, _RTC3_I2C_ADDRESS );
+#else
+    rtc3_i2cDriverInit( (T_RTC3_P)&_HOST_MIKROBUS_GPIO, (T_RTC3_P)&_HOST_MIKROBUS_I2C, _RTC3_I2C_ADDRESS );
+#endif
+    rtc3_setDateTime( &_dateTime );
+    rtc3_enableCounting();
+    rtc3_getSnapshot( &_snapshot );
+
+    printf( "api,ns_per_call,transactions_per_call,bytes_per_call,bus_us_100khz,bus_us_400khz,syscalls_per_call,cycles_per_call\n" );
+
+    for ( i = 0; i < sizeof( _cases ) / sizeof( _cases[ 0 ] ); i++ )
+    {
+        _run( &_cases[ i ], calls, stretchNs );
+    }
+
+    return 0;
+}
+
+                                                                       /** @} */
+/* -------------------------------------------------------------------------- */
+/*
+  rtc3_bench.c
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+3. All advertising materials mentioning features or use of this software
+   must display the following acknowledgement:
+   This product includes software developed by the MikroElektonika.
+
+4. Neither the name of the MikroElektonika nor the
+   names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY MIKROELEKTRONIKA ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL MIKROELEKTRONIKA BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------------- */
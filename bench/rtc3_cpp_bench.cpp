@@ -0,0 +1,338 @@
+/*
+    rtc3_cpp_bench.cpp
+
+-----------------------------------------------------------------------------
+
+  This file is part of mikroSDK.
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+----------------------------------------------------------------------------- */
+
+/**
+@file   rtc3_cpp_bench.cpp
+@brief    RTC 3 Click C++ driver against the C driver
+*/
+/**
+@defgroup   RTC3_CPP_BENCH
+@brief      rtc3::Device< rtc3::SimBus > calls against the matching C calls
+@{
+
+Both drivers run against the BQ32000 model. The C driver is built with
+__HAL_STATS__, the C++ one on a bus policy over rtc3::SimBus counting
+the same things, so both pay for the same accounting. For each pair of
+matching calls one CSV row is printed :
+
+- c_api, cpp_api : the two calls;
+- c_ns, cpp_ns : host time per call, best of several rounds, including
+  the simulated bus;
+- c_transactions, cpp_transactions : START ... STOP transactions per call;
+- c_bytes, cpp_bytes : bytes on the bus per call, address bytes included;
+- c_bus_us, cpp_bus_us : wire time of one call at 100 kHz;
+- same : 1 when transactions, bytes and wire time are equal.
+
+The exit code is 1 when any pair differs on the bus.
+
+    make -C bench run-cpp
+    ./rtc3_cpp_bench [calls]
+
+*/
+/* -------------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "__rtc3_driver.h"
+#include "rtc3.hpp"
+
+/* ------------------------------------------------------------------- MACROS */
+
+#define _BENCH_CALLS_DEFAULT                                              20000UL
+#define _BENCH_ROUNDS                                                     5
+
+/* ----------------------------------------------------------------- VARIABLES */
+
+typedef void (*bench_fn_t)();
+
+typedef struct
+{
+    const char  *cName;
+    bench_fn_t  cFn;
+    const char  *cppName;
+    bench_fn_t  cppFn;
+
+}bench_pair_t;
+
+typedef struct
+{
+    uint64_t    ns;
+    uint32_t    transactions;
+    uint32_t    bytes;
+    uint64_t    busNs;
+
+}bench_result_t;
+
+// Same accounting as the __HAL_STATS__ wrappers of the C driver
+struct CountingBus
+{
+    static uint32_t transactions;
+    static uint32_t bytes;
+
+    static void start()
+    {
+        rtc3::SimBus::start();
+    }
+
+    static void write( uint8_t slave, uint8_t *pBuf, uint16_t nBytes, uint8_t endMode )
+    {
+        rtc3::SimBus::write( slave, pBuf, nBytes, endMode );
+        bytes += nBytes + 1;
+        transactions += ( endMode == rtc3::END_MODE_STOP );
+    }
+
+    static void read( uint8_t slave, uint8_t *pBuf, uint16_t nBytes, uint8_t endMode )
+    {
+        rtc3::SimBus::read( slave, pBuf, nBytes, endMode );
+        bytes += nBytes + 1;
+        transactions += ( endMode == rtc3::END_MODE_STOP );
+    }
+};
+
+uint32_t CountingBus::transactions;
+uint32_t CountingBus::bytes;
+
+static rtc3::Device< CountingBus >  _device;
+static rtc3_datetime_t              _cDateTime = { 56, 34, 12, 3, 15, 5, 2024 };
+static rtc3::DateTime               _cppDateTime = { 56, 34, 12, 3, 15, 5, 2024 };
+static volatile uint32_t            _sink;
+
+/* ------------------------------------------------------------ BENCH CASES */
+
+static void _cSyncShadow()              { rtc3_syncShadow(); }
+static void _cppInit()                  { _device.init(); }
+
+static void _cGetDateTime()
+{
+    rtc3_datetime_t dt;
+
+    rtc3_getDateTime( &dt );
+    _sink += dt.timeSeconds;
+}
+
+static void _cppGetDateTime()
+{
+    rtc3::DateTime dt;
+
+    _device.getDateTime( dt );
+    _sink += dt.timeSeconds;
+}
+
+static void _cSetDateTime()             { rtc3_setDateTime( &_cDateTime ); }
+static void _cppSetDateTime()           { _device.setDateTime( _cppDateTime ); }
+
+static void _cReadByte()                { _sink += rtc3_readByte( _RTC3_REG_TIME_MIN ); }
+
+static void _cppReadBlock()
+{
+    uint8_t value;
+
+    _device.readBlock< rtc3::REG_TIME_MIN >( &value, 1 );
+    _sink += value;
+}
+
+static void _cEnableCounting()          { rtc3_enableCounting(); }
+static void _cppWriteStop0()            { _device.write< rtc3::STOP >( 0 ); }
+static void _cDisableCounting()         { rtc3_disableCounting(); }
+static void _cppWriteStop1()            { _device.write< rtc3::STOP >( 1 ); }
+static void _cSetCalibration()          { rtc3_setCalibration( 0, 5 ); }
+static void _cppWriteCal()              { _device.write< rtc3::CAL_S, rtc3::CAL >( 0, 5 ); }
+static void _cSetTrickleCharge()        { rtc3_setTrickleCharge( 1 ); }
+static void _cppWriteTch2()             { _device.write< rtc3::TCH2 >( 1 ); }
+static void _cSetTrickleChargeBypass()  { rtc3_setTrickleChargeBypass( 1 ); }
+static void _cppWriteTcfe()             { _device.write< rtc3::TCFE >( 1 ); }
+
+static void _cSetFtf()
+{
+    rtc3_setSpecialFunctionKey1( rtc3::SF_KEY1_VALUE );
+    rtc3_setSpecialFunctionKey2( rtc3::SF_KEY2_VALUE );
+    rtc3_setFrequencyCalibration( 1 );
+}
+
+static void _cppWriteFtf()              { _device.write< rtc3::FTF >( 1 ); }
+
+static const bench_pair_t _pairs[] =
+{
+    { "rtc3_syncShadow",                _cSyncShadow,               "init",                 _cppInit },
+    { "rtc3_getDateTime",               _cGetDateTime,              "getDateTime",          _cppGetDateTime },
+    { "rtc3_setDateTime",               _cSetDateTime,              "setDateTime",          _cppSetDateTime },
+    { "rtc3_readByte",                  _cReadByte,                 "readBlock<TIME_MIN>",  _cppReadBlock },
+    { "rtc3_enableCounting",            _cEnableCounting,           "write<STOP>(0)",       _cppWriteStop0 },
+    { "rtc3_disableCounting",           _cDisableCounting,          "write<STOP>(1)",       _cppWriteStop1 },
+    { "rtc3_setCalibration",            _cSetCalibration,           "write<CAL_S+CAL>",     _cppWriteCal },
+    { "rtc3_setTrickleCharge",          _cSetTrickleCharge,         "write<TCH2>",          _cppWriteTch2 },
+    { "rtc3_setTrickleChargeBypass",    _cSetTrickleChargeBypass,   "write<TCFE>",          _cppWriteTcfe },
+    { "rtc3_setFrequencyCalibration",   _cSetFtf,                   "write<FTF>",           _cppWriteFtf }
+};
+
+/* ----------------------------------------------------------- PRIVATE FUNCTIONS */
+
+static uint64_t _nowNs()
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t _bestNs( bench_fn_t fn, uint32_t calls )
+{
+    uint64_t best;
+    uint64_t elapsed;
+    uint32_t i;
+    uint8_t round;
+
+    best = 0;
+
+    for ( round = 0; round < _BENCH_ROUNDS; round++ )
+    {
+        elapsed = _nowNs();
+
+        for ( i = 0; i < calls; i++ )
+        {
+            fn();
+        }
+
+        elapsed = _nowNs() - elapsed;
+
+        if ( round == 0 || elapsed < best )
+        {
+            best = elapsed;
+        }
+    }
+
+    return best / calls;
+}
+
+static void _runC( bench_fn_t fn, uint32_t calls, bench_result_t *result )
+{
+    rtc3_stats_t stats;
+
+    rtc3_resetStats();
+    result->busNs = rtc3sim_getBusTime();
+    fn();
+    result->busNs = rtc3sim_getBusTime() - result->busNs;
+    rtc3_getStats( &stats );
+
+    result->transactions = stats.transactions;
+    result->bytes = stats.bytesWritten + stats.bytesRead;
+    result->ns = _bestNs( fn, calls );
+}
+
+static void _runCpp( bench_fn_t fn, uint32_t calls, bench_result_t *result )
+{
+    CountingBus::transactions = 0;
+    CountingBus::bytes = 0;
+    result->busNs = rtc3sim_getBusTime();
+    fn();
+    result->busNs = rtc3sim_getBusTime() - result->busNs;
+
+    result->transactions = CountingBus::transactions;
+    result->bytes = CountingBus::bytes;
+    result->ns = _bestNs( fn, calls );
+}
+
+/* --------------------------------------------------------------------- MAIN */
+
+int main( int argc, char **argv )
+{
+    bench_result_t c;
+    bench_result_t cpp;
+    uint32_t calls;
+    uint8_t same;
+    uint8_t differ;
+    uint8_t i;
+
+    calls = ( argc > 1 ) ? (uint32_t)strtoul( argv[ 1 ], 0, 0 ) : _BENCH_CALLS_DEFAULT;
+
+    if ( calls == 0 )
+    {
+        fprintf( stderr, "usage: %s [calls]\n", argv[ 0 ] );
+        return 1;
+    }
+
+    rtc3sim_reset();
+    rtc3sim_setBusTiming( 100000UL, 0 );
+    rtc3_i2cDriverInit( (T_RTC3_P)&_HOST_MIKROBUS_GPIO, (T_RTC3_P)&_HOST_MIKROBUS_I2C, _RTC3_I2C_ADDRESS );
+    _device.init();
+
+    printf( "c_api,cpp_api,c_ns,cpp_ns,c_transactions,cpp_transactions,c_bytes,cpp_bytes,c_bus_us,cpp_bus_us,same\n" );
+    differ = 0;
+
+    for ( i = 0; i < sizeof( _pairs ) / sizeof( _pairs[ 0 ] ); i++ )
+    {
+        _runC( _pairs[ i ].cFn, calls, &c );
+        _runCpp( _pairs[ i ].cppFn, calls, &cpp );
+
+        same = ( c.transactions == cpp.transactions ) && ( c.bytes == cpp.bytes ) && ( c.busNs == cpp.busNs );
+        differ |= !same;
+
+        printf( "%s,%s,%llu,%llu,%u,%u,%u,%u,%.1f,%.1f,%u\n",
+                _pairs[ i ].cName,
+                _pairs[ i ].cppName,
+                (unsigned long long)c.ns,
+                (unsigned long long)cpp.ns,
+                c.transactions,
+                cpp.transactions,
+                c.bytes,
+                cpp.bytes,
+                c.busNs / 1000.0,
+                cpp.busNs / 1000.0,
+                same );
+    }
+
+    return differ;
+}
+
+                                                                       /** @} */
+/* -------------------------------------------------------------------------- */
+/*
+  rtc3_cpp_bench.cpp
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+3. All advertising materials mentioning features or use of this software
+   must display the following acknowledgement:
+   This product includes software developed by the MikroElektonika.
+
+4. Neither the name of the MikroElektonika nor the
+   names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY MIKROELEKTRONIKA ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL MIKROELEKTRONIKA BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------------- */
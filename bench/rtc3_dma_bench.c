@@ -0,0 +1,222 @@
+/*
+    rtc3_dma_bench.c
+
+-----------------------------------------------------------------------------
+
+  This file is part of mikroSDK.
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+----------------------------------------------------------------------------- */
+
+/**
+@file   rtc3_dma_bench.c
+@brief    RTC 3 Click DMA transfer benchmark
+*/
+/**
+@defgroup   RTC3_DMA_BENCH
+@brief      CPU time per date and time read, blocking against DMA
+@{
+
+The driver is built with __HAL_I2C_DMA__ against the BQ32000 model. The
+same read, rtc3_getDateTime, is made with the blocking master and through
+rtc3_getDateTimeAsync with rtc3_poll called every poll period of simulated
+time. The blocking master spins for the whole wire time, so its CPU time is
+the host time of the call plus the modelled bus time. With DMA the CPU is
+only busy inside rtc3_getDateTimeAsync and rtc3_poll. One CSV row per mode
+and SCL frequency :
+
+- mode : blocking, dma, or dma_nack ( no slave at the address );
+- scl_khz : bus clock;
+- cpu_ns_per_read : CPU time per read;
+- bus_us_per_read : wire time per read, as modelled by the simulator;
+- polls_per_read : rtc3_poll calls until the done callback;
+- errors : reads whose done callback reported an error.
+
+    make -C bench run-dma
+    ./rtc3_dma_bench [reads] [poll_us]
+
+*/
+/* -------------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "__rtc3_driver.h"
+#include "__rtc3_sim.h"
+
+/* ------------------------------------------------------------------- MACROS */
+
+#define _BENCH_READS_DEFAULT                                              2000UL
+#define _BENCH_POLL_US_DEFAULT                                            50UL
+
+/* ----------------------------------------------------------------- VARIABLES */
+
+static rtc3_datetime_t  _dateTime;
+static uint32_t         _errors;
+
+/* ----------------------------------------------------------- PRIVATE FUNCTIONS */
+
+static uint64_t _nowNs()
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void _done( uint8_t error )
+{
+    _errors += error;
+}
+
+static void _init( uint8_t slave, uint32_t sclHz )
+{
+    rtc3sim_reset();
+    rtc3sim_setBusTiming( sclHz, 0 );
+    rtc3_i2cDriverInit( (T_RTC3_P)&_HOST_MIKROBUS_GPIO, (T_RTC3_P)&_HOST_MIKROBUS_I2C, slave );
+
+    _errors = 0;
+}
+
+static void _blocking( uint32_t reads, uint32_t sclHz )
+{
+    uint64_t cpu;
+    uint64_t bus;
+    uint64_t stamp;
+    uint32_t i;
+
+    _init( _RTC3_I2C_ADDRESS, sclHz );
+    cpu = 0;
+    bus = rtc3sim_getTime();
+
+    for ( i = 0; i < reads; i++ )
+    {
+        stamp = _nowNs();
+        rtc3_getDateTime( &_dateTime );
+        cpu += _nowNs() - stamp;
+    }
+
+    bus = rtc3sim_getTime() - bus;
+
+    printf( "blocking,%u,%.0f,%.1f,0.0,0\n",
+            sclHz / 1000,
+            (double)( cpu + bus ) / reads,
+            (double)bus / reads / 1000.0 );
+}
+
+static void _dma( const char *mode, uint8_t slave, uint32_t reads, uint32_t sclHz, uint32_t pollUs )
+{
+    uint64_t cpu;
+    uint64_t bus;
+    uint64_t stamp;
+    uint32_t polls;
+    uint32_t i;
+
+    _init( slave, sclHz );
+    cpu = 0;
+    polls = 0;
+    bus = rtc3sim_getTime();
+
+    for ( i = 0; i < reads; i++ )
+    {
+        stamp = _nowNs();
+        rtc3_getDateTimeAsync( &_dateTime, _done );
+        cpu += _nowNs() - stamp;
+
+        // The channel runs on its own while the CPU is elsewhere
+        while ( rtc3_asyncBusy() )
+        {
+            rtc3sim_advance( (uint64_t)pollUs * 1000 );
+
+            stamp = _nowNs();
+            rtc3_poll();
+            cpu += _nowNs() - stamp;
+            polls++;
+        }
+    }
+
+    bus = rtc3sim_getTime() - bus;
+
+    printf( "%s,%u,%.0f,%.1f,%.1f,%u\n",
+            mode,
+            sclHz / 1000,
+            (double)cpu / reads,
+            (double)bus / reads / 1000.0,
+            (double)polls / reads,
+            _errors );
+}
+
+/* --------------------------------------------------------------------- MAIN */
+
+int main( int argc, char **argv )
+{
+    static const uint32_t sclHz[] = { 100000UL, 400000UL };
+    uint32_t reads;
+    uint32_t pollUs;
+    uint8_t i;
+
+    reads = ( argc > 1 ) ? (uint32_t)strtoul( argv[ 1 ], 0, 0 ) : _BENCH_READS_DEFAULT;
+    pollUs = ( argc > 2 ) ? (uint32_t)strtoul( argv[ 2 ], 0, 0 ) : _BENCH_POLL_US_DEFAULT;
+
+    if ( ( reads == 0 ) || ( pollUs == 0 ) )
+    {
+        fprintf( stderr, "usage: %s [reads] [poll_us]\n", argv[ 0 ] );
+        return 1;
+    }
+
+    printf( "mode,scl_khz,cpu_ns_per_read,bus_us_per_read,polls_per_read,errors\n" );
+
+    for ( i = 0; i < sizeof( sclHz ) / sizeof( sclHz[ 0 ] ); i++ )
+    {
+        _blocking( reads, sclHz[ i ] );
+        _dma( "dma", _RTC3_I2C_ADDRESS, reads, sclHz[ i ], pollUs );
+        _dma( "dma_nack", 0x69, reads, sclHz[ i ], pollUs );
+    }
+
+    return 0;
+}
+
+                                                                       /** @} */
+/* -------------------------------------------------------------------------- */
+/*
+  rtc3_dma_bench.c
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+3. All advertising materials mentioning features or use of this software
+   must display the following acknowledgement:
+   This product includes software developed by the MikroElektonika.
+
+4. Neither the name of the MikroElektonika nor the
+   names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY MIKROELEKTRONIKA ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL MIKROELEKTRONIKA BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------------- */
@@ -0,0 +1,288 @@
+/*
+    rtc3_shm_bench.c
+
+-----------------------------------------------------------------------------
+
+  This file is part of mikroSDK.
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+----------------------------------------------------------------------------- */
+
+/**
+@file   rtc3_shm_bench.c
+@brief    RTC 3 Click shared memory reader stress benchmark
+*/
+/**
+@defgroup   RTC3_SHM_BENCH
+@brief      rtc3_shmRead under many reader threads and a busy publisher
+@{
+
+A publisher thread writes samples whose fields are all derived from one
+counter, either once per second like rtc3d or back to back, while 1 to
+the given number of reader threads call rtc3_shmRead. Every sample read
+is checked, a mixed sample counts as torn. One CSV row per run :
+
+- readers : reader threads;
+- publish : 1hz or max;
+- publishes : samples published during the run;
+- ns_per_read : average rtc3_shmRead time per reader;
+- reads_per_s : total reads per second over all readers;
+- torn : inconsistent samples, must be 0.
+
+    make -C bench run-shm
+    ./rtc3_shm_bench [max readers] [ms per run]
+
+*/
+/* -------------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+
+#include "rtc3_shm.h"
+
+/* ------------------------------------------------------------------- MACROS */
+
+#define _BENCH_READERS_DEFAULT                                            16
+#define _BENCH_RUN_MS_DEFAULT                                             500
+
+/* ----------------------------------------------------------------- VARIABLES */
+
+typedef struct
+{
+    pthread_t   thread;
+    uint64_t    reads;
+    uint64_t    torn;
+
+}bench_reader_t;
+
+static rtc3_shm_t       *_shm;
+static volatile int     _running;
+static uint8_t          _publishMax;
+static uint64_t         _publishes;
+
+/* ----------------------------------------------------------- PRIVATE FUNCTIONS */
+
+static uint64_t _nowNs()
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void _sampleMake( uint32_t count, rtc3_shmSample_t *sample )
+{
+    uint8_t cnt;
+
+    sample->stampNs = (uint64_t)count * 1000000000ULL;
+    sample->epoch = count;
+    sample->readLatencyNs = ~count;
+
+    for ( cnt = 0; cnt < 7; cnt++ )
+    {
+        sample->reg[ cnt ] = (uint8_t)( count + cnt );
+    }
+
+    sample->status = (uint8_t)( count >> 8 );
+}
+
+static int _sampleCheck( const rtc3_shmSample_t *sample )
+{
+    rtc3_shmSample_t expected;
+
+    _sampleMake( sample->epoch, &expected );
+
+    return memcmp( sample, &expected, sizeof( rtc3_shmSample_t ) ) == 0;
+}
+
+static void *_publisher( void *arg )
+{
+    rtc3_shmSample_t sample;
+    uint64_t next;
+    uint32_t count;
+
+    ( void )arg;
+    count = 0;
+    next = _nowNs();
+
+    while ( _running )
+    {
+        if ( !_publishMax )
+        {
+            if ( _nowNs() < next )
+            {
+                usleep( 1000 );
+                continue;
+            }
+
+            next += 1000000000ULL;
+        }
+
+        _sampleMake( ++count, &sample );
+        rtc3_shmPublish( _shm, &sample );
+    }
+
+    _publishes = count;
+
+    return 0;
+}
+
+static void *_reader( void *arg )
+{
+    bench_reader_t *reader;
+    rtc3_shmSample_t sample;
+
+    reader = ( bench_reader_t * )arg;
+
+    while ( _running )
+    {
+        rtc3_shmRead( _shm, &sample );
+
+        if ( !_sampleCheck( &sample ) )
+        {
+            reader->torn++;
+        }
+
+        reader->reads++;
+    }
+
+    return 0;
+}
+
+static void _run( uint32_t readers, uint8_t publishMax, uint32_t runMs )
+{
+    bench_reader_t *reader;
+    pthread_t publisher;
+    rtc3_shmSample_t sample;
+    uint64_t reads;
+    uint64_t torn;
+    uint64_t elapsed;
+    uint32_t cnt;
+
+    reader = calloc( readers, sizeof( bench_reader_t ) );
+
+    _sampleMake( 0, &sample );
+    rtc3_shmPublish( _shm, &sample );
+
+    _running = 1;
+    _publishMax = publishMax;
+    elapsed = _nowNs();
+
+    pthread_create( &publisher, 0, _publisher, 0 );
+
+    for ( cnt = 0; cnt < readers; cnt++ )
+    {
+        pthread_create( &reader[ cnt ].thread, 0, _reader, &reader[ cnt ] );
+    }
+
+    usleep( runMs * 1000 );
+    _running = 0;
+
+    pthread_join( publisher, 0 );
+
+    reads = 0;
+    torn = 0;
+
+    for ( cnt = 0; cnt < readers; cnt++ )
+    {
+        pthread_join( reader[ cnt ].thread, 0 );
+        reads += reader[ cnt ].reads;
+        torn += reader[ cnt ].torn;
+    }
+
+    elapsed = _nowNs() - elapsed;
+
+    printf( "%u,%s,%llu,%.1f,%.0f,%llu\n",
+            readers,
+            publishMax ? "max" : "1hz",
+            (unsigned long long)_publishes,
+            (double)elapsed * readers / reads,
+            (double)reads * 1000000000.0 / elapsed,
+            (unsigned long long)torn );
+
+    free( reader );
+}
+
+/* --------------------------------------------------------------------- MAIN */
+
+int main( int argc, char **argv )
+{
+    char name[ 32 ];
+    uint32_t maxReaders;
+    uint32_t runMs;
+    uint32_t readers;
+
+    maxReaders = ( argc > 1 ) ? (uint32_t)strtoul( argv[ 1 ], 0, 0 ) : _BENCH_READERS_DEFAULT;
+    runMs = ( argc > 2 ) ? (uint32_t)strtoul( argv[ 2 ], 0, 0 ) : _BENCH_RUN_MS_DEFAULT;
+
+    snprintf( name, sizeof( name ), "/rtc3_bench_%d", (int)getpid() );
+    _shm = rtc3_shmCreate( name );
+
+    if ( _shm == 0 )
+    {
+        perror( name );
+        return 1;
+    }
+
+    printf( "readers,publish,publishes,ns_per_read,reads_per_s,torn\n" );
+
+    for ( readers = 1; readers <= maxReaders; readers <<= 1 )
+    {
+        _run( readers, 0, runMs );
+        _run( readers, 1, runMs );
+    }
+
+    rtc3_shmClose( _shm );
+    shm_unlink( name );
+
+    return 0;
+}
+
+                                                                       /** @} */
+/* -------------------------------------------------------------------------- */
+/*
+  rtc3_shm_bench.c
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+3. All advertising materials mentioning features or use of this software
+   must display the following acknowledgement:
+   This product includes software developed by the MikroElektonika.
+
+4. Neither the name of the MikroElektonika nor the
+   names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY MIKROELEKTRONIKA ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL MIKROELEKTRONIKA BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------------- */
@@ -23,57 +23,22 @@ The application is composed of three sections :
      RTC 3 Click communicates with register via I2C by write to register and read from register,
      set time and date, get time and date, enable and disable counting
      and set frequency by write configuration register.
+     The 1 Hz calibration output on the INT pin drives the tick service,
+     so the date and time are read over I2C only once per second.
+     Each second is formatted by the driver into one buffer
+     and written to the log with a single call.
      Results are being sent to the Usart Terminal where you can track their changes.
      All data logs write on usb uart changes for every 1 sec.
 
-Additional Functions :
-
-- void displayLogDayOfTheWeek( uint8_t dayOfTheWeek ) - Write day of the week log on USART terminal.
-- void displayLogUart( uint8_t value ) - Write the value of time or date as a two-digit number.
-
 */
 
 #include "Click_RTC_3_types.h"
 #include "Click_RTC_3_config.h"
 
-uint8_t timeHours;
-uint8_t timeMinutes;
-uint8_t timeSeconds;
-uint8_t dayOfTheWeek;
-uint8_t dateDay;
-uint8_t dateMonth;
-uint16_t dateYear;
-uint8_t timeSecondsNew = 0xFF;
+rtc3_datetime_t dateTime;
+rtc3_snapshot_t snapshot;
 char logText[50];
 
-void displayLogDayOfTheWeek( uint8_t dayOfTheWeek )
-{
-    if ( dayOfTheWeek == 1 )
-        mikrobus_logWrite( "      Monday      ", _LOG_LINE );
-    if ( dayOfTheWeek == 2 )
-        mikrobus_logWrite( "      Tuesday     ", _LOG_LINE );
-    if ( dayOfTheWeek == 3 )
-        mikrobus_logWrite( "     Wednesday    ", _LOG_LINE );
-    if ( dayOfTheWeek == 4 )
-        mikrobus_logWrite( "     Thursday     ", _LOG_LINE );
-    if ( dayOfTheWeek == 5 )
-        mikrobus_logWrite( "      Friday      ", _LOG_LINE );
-    if ( dayOfTheWeek == 6 )
-        mikrobus_logWrite( "     Saturday     ", _LOG_LINE );
-    if ( dayOfTheWeek == 7 )
-        mikrobus_logWrite( "      Sunday      ", _LOG_LINE );
-}
-
-void displayLogUart( uint8_t value )
-{
-    IntToStr( value / 10, logText );
-    ltrim( logText );
-    mikrobus_logWrite( logText, _LOG_TEXT );
-    IntToStr( value % 10, logText );
-    ltrim( logText );
-    mikrobus_logWrite( logText, _LOG_TEXT );
-}
-
 void systemInit()
 {
     mikrobus_gpioInit( _MIKROBUS1, _MIKROBUS_INT_PIN, _GPIO_INPUT );
@@ -99,54 +64,25 @@ void applicationInit()
     rtc3_setDate( 1, 31, 12, 2018 );
     // Start counting
     rtc3_enableCounting();
+    // 1 Hz tick on the INT pin
+    rtc3_tickInit( 0 );
 }
 
 void applicationTask()
 {
-    rtc3_getTime( &timeHours, &timeMinutes, &timeSeconds );
-
-    rtc3_getDate( &dayOfTheWeek, &dateDay, &dateMonth, &dateYear );
-
-    if ( timeSecondsNew != timeSeconds )
+    if ( rtc3_tickService() )
     {
-        if ( ( ( timeHours | timeMinutes | timeSeconds ) == 0 )  && ( ( dateDay | dateMonth ) == 1 ) )
+        rtc3_getSnapshot( &snapshot );
+        rtc3_decodeSnapshot( &snapshot, &dateTime );
+
+        if ( ( ( dateTime.timeHours | dateTime.timeMinutes | dateTime.timeSeconds ) == 0 )  && ( ( dateTime.dateDay | dateTime.dateMonth ) == 1 ) )
         {
             mikrobus_logWrite( "  Happy New Year  ", _LOG_LINE );
-            mikrobus_logWrite( "------------------", _LOG_LINE );
         }
-        
-        mikrobus_logWrite( " Time : ", _LOG_TEXT );
 
-        displayLogUart( timeHours );
-        mikrobus_logWrite( ":", _LOG_TEXT );
-
-        displayLogUart( timeMinutes );
-        mikrobus_logWrite( ":", _LOG_TEXT );
-
-        displayLogUart( timeSeconds );
-        mikrobus_logWrite( "", _LOG_LINE );
-
-        displayLogDayOfTheWeek( dayOfTheWeek );
-
-        mikrobus_logWrite( " Date: ", _LOG_TEXT );
-
-        displayLogUart( dateDay );
-        mikrobus_logWrite( ".", _LOG_TEXT );
-
-        displayLogUart( dateMonth );
-        mikrobus_logWrite( ".", _LOG_TEXT );
-
-        mikrobus_logWrite( "20", _LOG_TEXT );
-
-        displayLogUart( dateYear );
-        mikrobus_logWrite( ".", _LOG_LINE );
-
-        mikrobus_logWrite( "------------------", _LOG_LINE );
-
-        timeSecondsNew = timeSeconds;
+        rtc3_formatCustom( &snapshot, " %H:%M:%S  %A  %d.%m.%Y.", logText, sizeof( logText ) );
+        mikrobus_logWrite( logText, _LOG_LINE );
     }
-
-    Delay_1ms();
 }
 
 void main()
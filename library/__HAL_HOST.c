@@ -0,0 +1,186 @@
+/*
+    __HAL_HOST.c
+
+-----------------------------------------------------------------------------
+
+  This file is part of mikroSDK.
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+----------------------------------------------------------------------------- */
+
+/**
+@file   __HAL_HOST.c
+@brief    Host ( Linux/gcc ) HAL backed by the BQ32000 simulator
+*/
+/* -------------------------------------------------------------------------- */
+
+#include "__rtc3_sim.h"
+
+#define END_MODE_RESTART    0
+#define END_MODE_STOP       1
+
+#ifdef __HAL_I2C__
+
+typedef int (*T_hal_i2cStartFp)();
+typedef int (*T_hal_i2cWriteFp)(uint8_t, uint8_t*, uint16_t, uint8_t);
+typedef int (*T_hal_i2cReadFp)(uint8_t, uint8_t*, uint16_t, uint8_t);
+
+typedef struct
+{
+    T_hal_i2cStartFp    i2cStart;
+    T_hal_i2cWriteFp    i2cWrite;
+    T_hal_i2cReadFp     i2cRead;
+
+}T_hal_i2cObj;
+
+#ifdef __HAL_STATIC__
+
+// Simulator bus master and IRQ pin, unless the build names other functions
+#ifndef __HAL_STATIC_I2C_START__
+#define __HAL_STATIC_I2C_START__    rtc3sim_masterStart
+#endif
+#ifndef __HAL_STATIC_I2C_WRITE__
+#define __HAL_STATIC_I2C_WRITE__    rtc3sim_masterWrite
+#endif
+#ifndef __HAL_STATIC_I2C_READ__
+#define __HAL_STATIC_I2C_READ__     rtc3sim_masterRead
+#endif
+#ifndef __HAL_STATIC_INT_GET__
+#define __HAL_STATIC_INT_GET__      rtc3sim_getIrq
+#endif
+
+#else
+
+static T_hal_i2cStartFp fp_i2cStart;
+static T_hal_i2cWriteFp fp_i2cWrite;
+static T_hal_i2cReadFp  fp_i2cRead;
+
+static void hal_i2cMap(T_HAL_P i2cObj)
+{
+    T_HAL_I2C_OBJ tmp = (T_HAL_I2C_OBJ)i2cObj;
+
+    fp_i2cStart = tmp->i2cStart;
+    fp_i2cWrite = tmp->i2cWrite;
+    fp_i2cRead = tmp->i2cRead;
+}
+
+static int hal_i2cStart(void)
+{
+    return fp_i2cStart();
+}
+
+static int hal_i2cWrite(uint8_t slaveAddress, uint8_t *pBuf, uint16_t nBytes, uint8_t endMode)
+{
+    return fp_i2cWrite( slaveAddress, pBuf, nBytes, endMode );
+}
+
+static int hal_i2cRead(uint8_t slaveAddress, uint8_t *pBuf, uint16_t nBytes, uint8_t endMode)
+{
+    return fp_i2cRead( slaveAddress, pBuf, nBytes, endMode );
+}
+
+#endif
+#ifdef __HAL_I2C_ASYNC__
+
+static void hal_i2cAsyncStart(void)
+{
+    rtc3sim_i2cStart();
+}
+
+static void hal_i2cAsyncWrite(uint8_t dataByte)
+{
+    rtc3sim_i2cWrite( dataByte );
+}
+
+static void hal_i2cAsyncRead(uint8_t ack)
+{
+    rtc3sim_i2cRead( ack );
+}
+
+static void hal_i2cAsyncStop(void)
+{
+    rtc3sim_i2cStop();
+}
+
+static uint8_t hal_i2cAsyncDone(void)
+{
+    return rtc3sim_i2cDone();
+}
+
+static uint8_t hal_i2cAsyncResult(void)
+{
+    return rtc3sim_i2cResult();
+}
+
+#endif
+#ifdef __HAL_I2C_DMA__
+
+static int hal_i2cDmaTransfer(uint8_t slaveAddress, uint8_t *pWrite, uint16_t nWrite, uint8_t *pRead, uint16_t nRead)
+{
+    rtc3sim_dmaDesc_t desc[ 2 ];
+
+    desc[ 0 ].pBuf = pWrite;
+    desc[ 0 ].nBytes = nWrite;
+    desc[ 0 ].read = 0;
+
+    desc[ 1 ].pBuf = pRead;
+    desc[ 1 ].nBytes = nRead;
+    desc[ 1 ].read = 1;
+
+    return rtc3sim_dmaStart( slaveAddress, desc, ( nRead != 0 ) ? 2 : 1 );
+}
+
+static uint8_t hal_i2cDmaDone(void)
+{
+    return rtc3sim_dmaDone();
+}
+
+static uint8_t hal_i2cDmaError(void)
+{
+    return rtc3sim_dmaError();
+}
+
+#endif
+#endif
+
+/* -------------------------------------------------------------------------- */
+/*
+  __HAL_HOST.c
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+3. All advertising materials mentioning features or use of this software
+   must display the following acknowledgement:
+   This product includes software developed by the MikroElektonika.
+
+4. Neither the name of the MikroElektonika nor the
+   names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY MIKROELEKTRONIKA ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL MIKROELEKTRONIKA BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------------- */
@@ -0,0 +1,205 @@
+/*
+    __HAL_LINUX.c
+
+-----------------------------------------------------------------------------
+
+  This file is part of mikroSDK.
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+----------------------------------------------------------------------------- */
+
+/**
+@file   __HAL_LINUX.c
+@brief    Linux userspace HAL over the i2c-dev interface
+*/
+/**
+@defgroup   RTC3_HAL_LINUX
+@brief      I2C through /dev/i2c-N with combined I2C_RDWR transactions
+@{
+
+Every message from a START up to its STOP is queued and handed to the
+kernel as one I2C_RDWR ioctl, so a register pointer write and the burst
+read behind its repeated START cost a single kernel crossing.
+
+The I2C object carries the open adapter and the ioctl to call, 0 selects
+ioctl(2). Any other function with the same signature can stand in for
+the kernel, rtc3sim_i2cdevIoctl runs the transfers on the BQ32000 model :
+
+    rtc3_linuxI2c_t bus = { open( "/dev/i2c-1", O_RDWR ), 0 };
+
+    rtc3_i2cDriverInit( (T_RTC3_P)&gpio, (T_RTC3_P)&bus, _RTC3_I2C_ADDRESS );
+
+*/
+/* -------------------------------------------------------------------------- */
+
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+#define END_MODE_RESTART    0
+#define END_MODE_STOP       1
+
+#ifdef __HAL_I2C__
+
+// Messages and written bytes of one START ... STOP transaction
+#define HAL_LINUX_MSG_MAX       4
+#define HAL_LINUX_WRITE_MAX     32
+
+typedef int (*T_hal_i2cIoctlFp)(int, unsigned long, void*);
+
+typedef struct
+{
+    int                 fd;
+    T_hal_i2cIoctlFp    i2cIoctl;
+
+}T_hal_i2cObj;
+
+static int                  hal_linuxFd;
+static T_hal_i2cIoctlFp     fp_i2cIoctl;
+
+static struct i2c_msg       hal_linuxMsg[ HAL_LINUX_MSG_MAX ];
+static uint8_t              hal_linuxMsgCount;
+static uint8_t              hal_linuxWrite[ HAL_LINUX_WRITE_MAX ];
+static uint8_t              hal_linuxWriteCount;
+
+static int hal_linuxIoctl(int fd, unsigned long request, void *arg)
+{
+    return ioctl( fd, request, arg );
+}
+
+static int hal_linuxQueue(uint8_t slaveAddress, uint8_t *pBuf, uint16_t nBytes, uint16_t flags)
+{
+    if ( hal_linuxMsgCount == HAL_LINUX_MSG_MAX )
+    {
+        return 1;
+    }
+
+    hal_linuxMsg[ hal_linuxMsgCount ].addr = slaveAddress;
+    hal_linuxMsg[ hal_linuxMsgCount ].flags = flags;
+    hal_linuxMsg[ hal_linuxMsgCount ].len = nBytes;
+    hal_linuxMsg[ hal_linuxMsgCount ].buf = pBuf;
+    hal_linuxMsgCount++;
+
+    return 0;
+}
+
+static int hal_linuxFlush(void)
+{
+    struct i2c_rdwr_ioctl_data rdwr;
+    int ret;
+
+    rdwr.msgs = hal_linuxMsg;
+    rdwr.nmsgs = hal_linuxMsgCount;
+
+    ret = fp_i2cIoctl( hal_linuxFd, I2C_RDWR, &rdwr );
+
+    hal_linuxMsgCount = 0;
+    hal_linuxWriteCount = 0;
+
+    return ( ret < 0 ) ? 1 : 0;
+}
+
+static void hal_i2cMap(T_HAL_P i2cObj)
+{
+    T_HAL_I2C_OBJ tmp = (T_HAL_I2C_OBJ)i2cObj;
+
+    hal_linuxFd = tmp->fd;
+    fp_i2cIoctl = ( tmp->i2cIoctl != 0 ) ? tmp->i2cIoctl : hal_linuxIoctl;
+}
+
+static int hal_i2cStart(void)
+{
+    hal_linuxMsgCount = 0;
+    hal_linuxWriteCount = 0;
+
+    return 0;
+}
+
+static int hal_i2cWrite(uint8_t slaveAddress, uint8_t *pBuf, uint16_t nBytes, uint8_t endMode)
+{
+    uint8_t *dst;
+    uint16_t cnt;
+
+    if ( hal_linuxWriteCount + nBytes > HAL_LINUX_WRITE_MAX )
+    {
+        hal_linuxMsgCount = 0;
+        hal_linuxWriteCount = 0;
+        return 1;
+    }
+
+    // Keep a copy, the caller's buffer may be gone by the STOP
+    dst = &hal_linuxWrite[ hal_linuxWriteCount ];
+
+    for ( cnt = 0; cnt < nBytes; cnt++ )
+    {
+        dst[ cnt ] = pBuf[ cnt ];
+    }
+
+    hal_linuxWriteCount += nBytes;
+
+    if ( hal_linuxQueue( slaveAddress, dst, nBytes, 0 ) != 0 )
+    {
+        hal_linuxMsgCount = 0;
+        hal_linuxWriteCount = 0;
+        return 1;
+    }
+
+    return ( endMode == END_MODE_STOP ) ? hal_linuxFlush() : 0;
+}
+
+static int hal_i2cRead(uint8_t slaveAddress, uint8_t *pBuf, uint16_t nBytes, uint8_t endMode)
+{
+    if ( hal_linuxQueue( slaveAddress, pBuf, nBytes, I2C_M_RD ) != 0 )
+    {
+        hal_linuxMsgCount = 0;
+        hal_linuxWriteCount = 0;
+        return 1;
+    }
+
+    return ( endMode == END_MODE_STOP ) ? hal_linuxFlush() : 0;
+}
+
+#endif
+
+                                                                       /** @} */
+/* -------------------------------------------------------------------------- */
+/*
+  __HAL_LINUX.c
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+3. All advertising materials mentioning features or use of this software
+   must display the following acknowledgement:
+   This product includes software developed by the MikroElektonika.
+
+4. Neither the name of the MikroElektonika nor the
+   names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY MIKROELEKTRONIKA ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL MIKROELEKTRONIKA BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------------- */
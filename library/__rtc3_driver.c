@@ -14,15 +14,67 @@
 #include "__rtc3_driver.h"
 #include "__rtc3_hal.c"
 
-/* ------------------------------------------------------------------- MACROS */
+#if defined( __HAL_I2C_ASYNC__ ) && !defined( __RTC3_ENABLE_ASYNC__ )
+#error "__HAL_I2C_ASYNC__ : define __RTC3_ENABLE_ASYNC__ for the asynchronous engine"
+#endif
+#if defined( __HAL_I2C_DMA__ ) && !defined( __RTC3_ENABLE_ASYNC__ )
+#error "__HAL_I2C_DMA__ : define __RTC3_ENABLE_ASYNC__ for the asynchronous engine"
+#endif
 
+/* ------------------------------------------------------------------- MACROS */
 
+// Largest contiguous register range moved by one block transaction ( 0x00 - 0x09 )
+#define _RTC3_BLOCK_SIZE_MAX                                              10
+
+// Asynchronous engine states, named after the bus step in progress
+#define _RTC3_ASYNC_IDLE                                                  0
+#define _RTC3_ASYNC_START                                                 1
+#define _RTC3_ASYNC_ADDRESS_WRITE                                         2
+#define _RTC3_ASYNC_POINTER                                               3
+#define _RTC3_ASYNC_RESTART                                               4
+#define _RTC3_ASYNC_ADDRESS_READ                                          5
+#define _RTC3_ASYNC_DATA                                                  6
+#define _RTC3_ASYNC_STOP                                                  7
+#define _RTC3_ASYNC_COMPLETE                                              8
+#define _RTC3_ASYNC_DMA                                                   9
+
+#define _RTC3_EVENT_RING_MASK                                             ( __RTC3_EVENT_RING_SIZE__ - 1 )
+
+// Sub-second clock, 512 Hz calibration output edges
+#define _RTC3_SUBSEC_HZ                                                   512
+#define _RTC3_SUBSEC_SHIFT                                                9
+#define _RTC3_SUBSEC_MASK                                                 0x01FF
+#define _RTC3_SUBSEC_WINDOW                                               4
+#define _RTC3_SUBSEC_LOCK_EDGES                                           1100
+#define _RTC3_SUBSEC_REF_SECONDS                                          0x00200000UL
+#define _RTC3_SUBSEC_SLIP_SHIFT                                           11
+
+// Sub-second clock, edge counter reads before giving up on the next 512 Hz edge
+#define _RTC3_SUBSEC_EDGE_POLLS                                           0x00100000UL
+
+// Software clock start, INT pin reads before giving up when there is no counter
+#define _RTC3_CLOCK_START_POLLS                                           0x00100000UL
+
+// Aligned set, write latency probes, the fastest one is used
+#define _RTC3_ALIGN_PROBES                                                4
+
+// Aligned set, oldest reference second accepted, in seconds
+#define _RTC3_ALIGN_MAX_AGE                                               4
+
+// Temperature drift table, 1 degree C points from -40 C, in units of 10 ppb
+#define _RTC3_TC_TEMP_MIN                                                 ( -400 )
+#define _RTC3_TC_TEMP_MAX                                                 869
+#define _RTC3_TC_DRIFT( t )                                               ( int16_t )( -( ( int32_t )( ( t ) - __RTC3_TC_TURNOVER__ ) * ( ( t ) - __RTC3_TC_TURNOVER__ ) * __RTC3_TC_COEFF_PPB__ + 5 ) / 10 )
+#define _RTC3_TC_ROW( t )                                                 _RTC3_TC_DRIFT( t ),     _RTC3_TC_DRIFT( t + 1 ), _RTC3_TC_DRIFT( t + 2 ), _RTC3_TC_DRIFT( t + 3 ), \
+                                                                          _RTC3_TC_DRIFT( t + 4 ), _RTC3_TC_DRIFT( t + 5 ), _RTC3_TC_DRIFT( t + 6 ), _RTC3_TC_DRIFT( t + 7 )
 
 /* ---------------------------------------------------------------- VARIABLES */
 
-#ifdef   __RTC3_DRV_I2C__
-static uint8_t _slaveAddress;
-#endif
+// Default instance, driven by the rtc3_* wrappers
+static rtc3_t _rtc3Default;
+
+// Instance whose bus and GPIO objects are currently mapped into the HAL
+static rtc3_t *_rtc3Active;
 
 // Register address
 const uint8_t _RTC3_I2C_ADDRESS                                          = 0x68;
@@ -52,504 +104,2827 @@ const uint8_t _RTC3_TCFE_OPEN                                            = 0x00;
 const uint8_t _RTC3_TCFE_CLOSED                                          = 0x20;
 const uint8_t _RTC3_FTF_NORMAL_512_HZ                                    = 0x00;
 const uint8_t _RTC3_FTF_1_HZ                                             = 0x01;
+const uint8_t _RTC3_CONFIG1_FT                                           = 0x40;
+const uint8_t _RTC3_SF_KEY1_VALUE                                        = 0x5E;
+const uint8_t _RTC3_SF_KEY2_VALUE                                        = 0xC7;
+
+const uint32_t _RTC3_EPOCH_MIN                                           = 946684800UL;
+const uint32_t _RTC3_EPOCH_MAX                                           = 4102444799UL;
+
+// Per-field value masks, ranges and minimums for registers 0x00 - 0x06
+static const uint8_t _fieldMask[ 7 ]  = { 0x7F, 0x7F, 0x3F, 0x07, 0x3F, 0x1F, 0xFF };
+static const uint8_t _fieldRange[ 7 ] = {   60,   60,   24,    8,   32,   13,  100 };
+static const uint8_t _fieldMin[ 7 ]   = {    0,    0,    0,    1,    1,    1,    0 };
+
+// Last register a rollover of each field changes, the weekday carries into nothing
+static const uint8_t _fieldCarry[ 7 ] = {    1,    2,    4,    3,    5,    6,    6 };
+
+// Days from 1st of March to the 1st of the month [ Jan - Dec ]
+static const uint16_t _epochMonthOffset[ 12 ] = { 306, 337, 0, 31, 61, 92, 122, 153, 184, 214, 245, 275 };
+
+// Weekday names, indexed by day of the week - 1
+static const char _weekdayName[ 7 ][ 10 ] =
+{
+    "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday", "Sunday"
+};
+
+// Binary to packed BCD [ 0 - 99 ]
+static const uint8_t _bcdEncodeTable[ 100 ] =
+{
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19,
+    0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29,
+    0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+    0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59,
+    0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79,
+    0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+    0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99
+};
+
+#ifdef __RTC3_ENABLE_TEMPCOMP__
+// Parabolic crystal drift, -40 C to +87 C, generated by the preprocessor
+static const int16_t _tcDrift[ 128 ] =
+{
+    _RTC3_TC_ROW( -40 ), _RTC3_TC_ROW( -32 ), _RTC3_TC_ROW( -24 ), _RTC3_TC_ROW( -16 ),
+    _RTC3_TC_ROW(  -8 ), _RTC3_TC_ROW(   0 ), _RTC3_TC_ROW(   8 ), _RTC3_TC_ROW(  16 ),
+    _RTC3_TC_ROW(  24 ), _RTC3_TC_ROW(  32 ), _RTC3_TC_ROW(  40 ), _RTC3_TC_ROW(  48 ),
+    _RTC3_TC_ROW(  56 ), _RTC3_TC_ROW(  64 ), _RTC3_TC_ROW(  72 ), _RTC3_TC_ROW(  80 )
+};
+#endif
 
 
 /* -------------------------------------------- PRIVATE FUNCTION DECLARATIONS */
 
+static uint8_t _bcdDecode( uint8_t bcd );
 
+static uint8_t _fieldDecode( uint8_t regAddress, uint8_t value );
 
-/* --------------------------------------------- PRIVATE FUNCTION DEFINITIONS */
+static uint8_t _fieldEncode( uint8_t regAddress, uint8_t value );
 
+static uint8_t _yearEncode( uint16_t dateYear );
 
+static void _dateTimeDecode( uint8_t *raw, rtc3_datetime_t *dateTime );
 
-/* --------------------------------------------------------- PUBLIC FUNCTIONS */
+static void _dateTimeEncode( rtc3_datetime_t *dateTime, uint8_t *raw );
 
-#ifdef   __RTC3_DRV_SPI__
+static void _ctxSelect( rtc3_t *ctx );
 
-void rtc3_spiDriverInit(T_RTC3_P gpioObj, T_RTC3_P spiObj)
-{
-    hal_spiMap( (T_HAL_P)spiObj );
-    hal_gpioMap( (T_HAL_P)gpioObj );
+static void _shadowUpdate( rtc3_t *ctx, uint8_t startReg, uint8_t *pBuf, uint8_t nBytes );
 
-    // ... power ON
-    // ... configure CHIP
-}
+static uint32_t _epochFromFields( uint8_t dateYear, uint8_t dateMonth, uint8_t dateDay, uint8_t timeHours, uint8_t timeMinutes, uint8_t timeSeconds );
 
+#ifdef __RTC3_ENABLE_CLOCK__
+static void _dateTimeIncrement( rtc3_datetime_t *dateTime );
 #endif
-#ifdef   __RTC3_DRV_I2C__
 
-void rtc3_i2cDriverInit(T_RTC3_P gpioObj, T_RTC3_P i2cObj, uint8_t slave)
-{
-    _slaveAddress = slave;
-    hal_i2cMap( (T_HAL_P)i2cObj );
-    hal_gpioMap( (T_HAL_P)gpioObj );
+static void _formatBcd( char *pBuf, uint8_t bcd );
 
-    // ... power ON
-    // ... configure CHIP
-}
+#ifdef __RTC3_ENABLE_CLOCK__
+static void _clockSync( rtc3_t *ctx );
 
+static void _clockCopy( volatile rtc3_datetime_t *dst, volatile rtc3_datetime_t *src );
+
+static void _clockPublish( rtc3_t *ctx );
 #endif
-#ifdef   __RTC3_DRV_UART__
 
-void rtc3_uartDriverInit(T_RTC3_P gpioObj, T_RTC3_P uartObj)
-{
-    hal_uartMap( (T_HAL_P)uartObj );
-    hal_gpioMap( (T_HAL_P)gpioObj );
+#ifdef __RTC3_ENABLE_SUBSEC__
+static uint32_t _subsecCount( rtc3_t *ctx );
 
-    // ... power ON
-    // ... configure CHIP
-}
+static uint8_t _subsecLock( rtc3_t *ctx, uint16_t maxEdges );
 
+static void _subsecPublish( rtc3_t *ctx, uint32_t edge, uint32_t epoch );
 #endif
 
+static int32_t _calibrationPpb( uint8_t config1 );
 
+static uint8_t _calibrationSelect( int32_t errorPpb );
 
-/* ----------------------------------------------------------- IMPLEMENTATION */
-
+static int32_t _ratioPpb( int32_t diff, uint32_t total );
 
+static uint8_t _waitRisingEdge( rtc3_t *ctx, rtc3_counter_t counter, uint32_t timeout, uint32_t *stamp );
 
-/* Generic read byte of data function */
-uint8_t rtc3_readByte( uint8_t regAddress )
-{
-    uint8_t rBuffer[ 1 ];
-    uint8_t wBuffer[ 1 ];
+#ifdef __RTC3_ENABLE_ASYNC__
+static uint8_t _asyncBegin( rtc3_t *ctx, uint8_t read, uint8_t startReg, uint8_t nBytes, rtc3_done_t done );
 
-    wBuffer[ 0 ] = regAddress;
+#ifdef __HAL_I2C_ASYNC__
+static void _asyncStep( rtc3_t *ctx );
+#endif
 
-    hal_i2cStart();
-    hal_i2cWrite( _slaveAddress, wBuffer, 1, END_MODE_RESTART );
-    hal_i2cRead( _slaveAddress, rBuffer, 2, END_MODE_STOP );
+static void _asyncFinish( rtc3_t *ctx );
+#endif
 
-    return rBuffer[ 0 ];
-}
+/* --------------------------------------------- PRIVATE FUNCTION DEFINITIONS */
 
-/* Generic write byte of data function */
-void rtc3_writeByte( uint8_t regAddress, uint8_t writeData )
+static uint8_t _bcdDecode( uint8_t bcd )
 {
-    uint8_t wBuffer[ 2 ];
+    uint8_t tens;
 
-    wBuffer[ 0 ] = regAddress;
-    wBuffer[ 1 ] = writeData;
+    // bcd - 6 * tens, without multiply or divide
+    tens = bcd >> 4;
 
-    hal_i2cStart();
-    hal_i2cWrite( _slaveAddress, wBuffer, 2, END_MODE_STOP );
+    return bcd - ( tens << 2 ) - ( tens << 1 );
 }
 
-/* Enable counting function */
-void rtc3_enableCounting()
+static uint8_t _fieldDecode( uint8_t regAddress, uint8_t value )
 {
-    uint8_t temp;
+    return _bcdDecode( value & _fieldMask[ regAddress ] );
+}
 
-    temp = rtc3_readByte( _RTC3_REG_TIME_SEC );
+static uint8_t _fieldEncode( uint8_t regAddress, uint8_t value )
+{
+    if ( value >= _fieldRange[ regAddress ] )
+    {
+        value %= _fieldRange[ regAddress ];
+    }
 
-    temp &= 0x7F;
+    if ( value < _fieldMin[ regAddress ] )
+    {
+        value = _fieldMin[ regAddress ];
+    }
 
-    rtc3_writeByte( _rtc3_REG_TIME_SEC, temp );
+    return _bcdEncodeTable[ value ];
 }
 
-/* Disable counting function */
-void rtc3_disableCounting()
+static uint8_t _yearEncode( uint16_t dateYear )
 {
-    uint8_t temp;
+    uint16_t step;
 
-    temp = rtc3_readByte( _RTC3_REG_TIME_SEC );
+    if ( dateYear >= 2000 )
+    {
+        dateYear -= 2000;
+    }
 
-    temp |= 0x80;
+    // Restoring division by 100, keeps the 16-bit % 100 off 8-bit targets
+    if ( dateYear >= 100 )
+    {
+        step = 51200;
+
+        do
+        {
+            if ( dateYear >= step )
+            {
+                dateYear -= step;
+            }
+            step >>= 1;
+        }
+        while ( step >= 100 );
+    }
 
-    rtc3_writeByte( _RTC3_REG_TIME_SEC, temp );
+    return _bcdEncodeTable[ dateYear ];
 }
 
-/* Get seconds function */
-uint8_t rtc3_getTimeSeconds()
+static void _dateTimeDecode( uint8_t *raw, rtc3_datetime_t *dateTime )
 {
-    uint8_t ones;
-    uint8_t tens;
-    uint8_t result;
-    uint8_t temp;
-
-    temp = rtc3_readByte( _RTC3_REG_TIME_SEC );
-
-    ones = temp & 0x0F;
+    dateTime->timeSeconds = _fieldDecode( _RTC3_REG_TIME_SEC, raw[ 0 ] );
+    dateTime->timeMinutes = _fieldDecode( _RTC3_REG_TIME_MIN, raw[ 1 ] );
+    dateTime->timeHours = _fieldDecode( _RTC3_REG_TIME_HOUR, raw[ 2 ] );
+    dateTime->dayOfTheWeek = _fieldDecode( _RTC3_REG_TIME_DAY_OF_THE_WEEK, raw[ 3 ] );
+    dateTime->dateDay = _fieldDecode( _RTC3_REG_TIME_DATE_DAY, raw[ 4 ] );
+    dateTime->dateMonth = _fieldDecode( _RTC3_REG_TIME_DATE_MONTH, raw[ 5 ] );
+    dateTime->dateYear = _fieldDecode( _RTC3_REG_TIME_DATE_YEAR, raw[ 6 ] );
+}
 
-    tens = ( temp & 0x70 ) >> 4;
+static void _dateTimeEncode( rtc3_datetime_t *dateTime, uint8_t *raw )
+{
+    raw[ 0 ] = _fieldEncode( _RTC3_REG_TIME_SEC, dateTime->timeSeconds );
+    raw[ 1 ] = _fieldEncode( _RTC3_REG_TIME_MIN, dateTime->timeMinutes );
+    raw[ 2 ] = _fieldEncode( _RTC3_REG_TIME_HOUR, dateTime->timeHours );
+    raw[ 3 ] = _fieldEncode( _RTC3_REG_TIME_DAY_OF_THE_WEEK, dateTime->dayOfTheWeek );
+    raw[ 4 ] = _fieldEncode( _RTC3_REG_TIME_DATE_DAY, dateTime->dateDay );
+    raw[ 5 ] = _fieldEncode( _RTC3_REG_TIME_DATE_MONTH, dateTime->dateMonth );
+    raw[ 6 ] = _yearEncode( dateTime->dateYear );
+}
 
-    result = ( 10 * tens ) + ones;
+static void _ctxSelect( rtc3_t *ctx )
+{
+    if ( _rtc3Active != ctx )
+    {
+#ifdef   __RTC3_DRV_I2C__
+        hal_i2cMap( (T_HAL_P)ctx->i2cObj );
+#endif
+        hal_gpioMap( (T_HAL_P)ctx->gpioObj );
 
-    return result;
+        _rtc3Active = ctx;
+    }
 }
 
-/* Set seconds function */
-void rtc3_setTimeSeconds( uint8_t seconds )
+static void _shadowUpdate( rtc3_t *ctx, uint8_t startReg, uint8_t *pBuf, uint8_t nBytes )
 {
-    uint8_t ones;
-    uint8_t tens;
-    uint8_t temp;
+    uint8_t regAddress;
+    uint8_t cnt;
+
+    // Written time registers are no longer the ones the delta poll has seen
+    if ( startReg <= _RTC3_REG_TIME_DATE_YEAR )
+    {
+        ctx->pollValid = 0;
+    }
 
-    ones = 0x00;
-    tens = 0x00;
+    for ( cnt = 0; cnt < nBytes; cnt++ )
+    {
+        regAddress = startReg + cnt;
+
+        if ( regAddress == _RTC3_REG_CONFIG1 )
+        {
+            ctx->shadowConfig1 = pBuf[ cnt ];
+        }
+        else if ( regAddress == _RTC3_REG_TRICKLE_CHARGE2 )
+        {
+            ctx->shadowTrickleCharge2 = pBuf[ cnt ];
+        }
+        else if ( regAddress == _RTC3_REG_CONFIG2 )
+        {
+            ctx->shadowConfig2 = pBuf[ cnt ];
+        }
+        else if ( regAddress == _RTC3_REG_SFR )
+        {
+            ctx->shadowSfr = pBuf[ cnt ];
+        }
+    }
+}
 
-    seconds %= 60;
+static uint32_t _epochFromFields( uint8_t dateYear, uint8_t dateMonth, uint8_t dateDay, uint8_t timeHours, uint8_t timeMinutes, uint8_t timeSeconds )
+{
+    uint16_t marchYear;
+    uint16_t days;
 
-    ones = seconds % 10;
+    if ( ( dateMonth < 1 ) || ( dateMonth > 12 ) )
+    {
+        dateMonth = 1;
+    }
 
-    tens = ( seconds / 10 ) << 4;
+    // Years start on the 1st of March, so the leap day is the last day of a year
+    marchYear = dateYear;
+    if ( dateMonth > 2 )
+    {
+        marchYear++;
+    }
 
-    temp = tens | ones;
+    // Days since 1999-03-01
+    days = 365 * marchYear + ( ( marchYear + 3 ) >> 2 ) + _epochMonthOffset[ dateMonth - 1 ] + dateDay - 1;
 
-    rtc3_writeByte( _RTC3_REG_TIME_SEC, temp );
+    // 1999-03-01 is day 10651 of the Unix epoch
+    return ( (uint32_t)days + 10651 ) * 86400 + (uint32_t)timeHours * 3600 + (uint16_t)timeMinutes * 60 + timeSeconds;
 }
 
-/* Get minutes function */
-uint8_t rtc3_getTimeMinutes()
+#ifdef __RTC3_ENABLE_CLOCK__
+static void _dateTimeIncrement( rtc3_datetime_t *dateTime )
 {
-    uint8_t ones;
-    uint8_t tens;
-    uint8_t result;
-    uint8_t temp;
+    static const uint8_t daysInMonth[ 12 ] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    uint8_t monthDays;
 
-    temp = rtc3_readByte( _RTC3_REG_TIME_MIN );
-
-    ones = temp & 0x0F;
-
-    tens = ( temp & 0x70 ) >> 4;
+    if ( ++dateTime->timeSeconds < 60 )
+    {
+        return;
+    }
+    dateTime->timeSeconds = 0;
 
-    result = ( 10 * tens ) + ones;
+    if ( ++dateTime->timeMinutes < 60 )
+    {
+        return;
+    }
+    dateTime->timeMinutes = 0;
 
-    return result;
-}
+    if ( ++dateTime->timeHours < 24 )
+    {
+        return;
+    }
+    dateTime->timeHours = 0;
 
-/* Set minutes function */
-void rtc3_setTimeMinutes( uint8_t minutes )
-{
-    uint8_t ones;
-    uint8_t tens;
-    uint8_t temp;
+    if ( ++dateTime->dayOfTheWeek > 7 )
+    {
+        dateTime->dayOfTheWeek = 1;
+    }
 
-    ones = 0x00;
-    tens = 0x00;
+    monthDays = daysInMonth[ ( dateTime->dateMonth - 1 ) % 12 ];
 
-    minutes %= 60;
+    if ( ( dateTime->dateMonth == 2 ) && ( ( dateTime->dateYear & 0x03 ) == 0 ) )
+    {
+        monthDays = 29;
+    }
 
-    ones = minutes % 10;
+    if ( ++dateTime->dateDay <= monthDays )
+    {
+        return;
+    }
+    dateTime->dateDay = 1;
 
-    tens = ( minutes / 10 ) << 4;
+    if ( ++dateTime->dateMonth <= 12 )
+    {
+        return;
+    }
+    dateTime->dateMonth = 1;
 
-    temp = tens | ones;
+    // Four digit years as well, stored two digit like the chip
+    dateTime->dateYear = dateTime->dateYear % 100 + 1;
 
-    rtc3_writeByte( _RTC3_REG_TIME_MIN, temp );
+    if ( dateTime->dateYear > 99 )
+    {
+        dateTime->dateYear = 0;
+    }
 }
+#endif
 
-/* Get hours function */
-uint8_t rtc3_getTimeHours()
+static void _formatBcd( char *pBuf, uint8_t bcd )
 {
-    uint8_t ones;
-    uint8_t tens;
-    uint8_t result;
-    uint8_t temp;
-
-    temp = rtc3_readByte( _RTC3_REG_TIME_HOUR );
-
-    ones = temp & 0x0F;
+    pBuf[ 0 ] = '0' + ( bcd >> 4 );
+    pBuf[ 1 ] = '0' + ( bcd & 0x0F );
+}
 
-    tens = ( temp & 0x30 ) >> 4;
+#ifdef __RTC3_ENABLE_CLOCK__
+static void _clockSync( rtc3_t *ctx )
+{
+    uint8_t edges;
 
-    result = ( 10 * tens ) + ones;
+    // Retry if an edge arrived while the registers were on the bus
+    do
+    {
+        edges = ctx->clockEdges;
+        rtc3_ctxGetDateTime( ctx, &ctx->clockSyncTime );
+    }
+    while ( edges != ctx->clockEdges );
 
-    return result;
+    ctx->clockSyncEdges = edges;
+    ctx->clockSyncPending = 1;
 }
 
-/* Set hours function */
-void rtc3_setTimeHours( uint8_t hours )
+static void _clockCopy( volatile rtc3_datetime_t *dst, volatile rtc3_datetime_t *src )
 {
-    uint8_t ones;
-    uint8_t tens;
-    uint8_t temp;
+    // Field by field through volatile, kept in order with the clockSeq accesses
+    dst->timeSeconds = src->timeSeconds;
+    dst->timeMinutes = src->timeMinutes;
+    dst->timeHours = src->timeHours;
+    dst->dayOfTheWeek = src->dayOfTheWeek;
+    dst->dateDay = src->dateDay;
+    dst->dateMonth = src->dateMonth;
+    dst->dateYear = src->dateYear;
+}
 
-    ones = 0x00;
-    tens = 0x00;
+static void _clockPublish( rtc3_t *ctx )
+{
+    uint8_t next;
 
-    hours %= 24;
+    // Fill the idle slot, then flip, a reader never sees a half written pair
+    next = ctx->clockPubIndex ^ 0x01;
 
-    ones = hours % 10;
+    ctx->clockPubEpoch[ next ] = rtc3_dateTimeToEpoch( &ctx->clockTime );
+    ctx->clockPubStamp[ next ] = ctx->clockEdgeStamp;
+    ctx->clockPubIndex = next;
+}
+#endif
 
-    tens = ( hours / 10 ) << 4;
+#ifdef __RTC3_ENABLE_SUBSEC__
+static uint32_t _subsecCount( rtc3_t *ctx )
+{
+    return ( ctx->subsecCounter != 0 ) ? ctx->subsecCounter() : ctx->subsecEdges;
+}
 
-    temp = tens | ones;
+static uint8_t _subsecLock( rtc3_t *ctx, uint16_t maxEdges )
+{
+    rtc3_snapshot_t snapshot;
+    rtc3_datetime_t dateTime;
+    uint32_t last;
+    uint32_t edge;
+    uint32_t polls;
+    uint8_t  seconds;
+    uint8_t  previous;
+    uint8_t  valid;
+
+    valid = 0;
+    previous = 0;
+    edge = _subsecCount( ctx );
+
+    while ( maxEdges != 0 )
+    {
+        maxEdges--;
+        last = edge;
+
+        // Sample the seconds register right behind an edge, no edge at all
+        // means FTF is still set, INT is not wired or the counter is stuck
+        polls = 0;
+
+        do
+        {
+            if ( ++polls > _RTC3_SUBSEC_EDGE_POLLS )
+            {
+                return 1;
+            }
+
+            edge = _subsecCount( ctx );
+        }
+        while ( edge == last );
+
+        seconds = rtc3_ctxReadByte( ctx, _RTC3_REG_TIME_SEC ) & 0x7F;
+
+        // The read must fit between two edges to be tied to one of them
+        if ( _subsecCount( ctx ) != edge )
+        {
+            valid = 0;
+            continue;
+        }
+
+        // Old second behind the previous edge, new one behind this edge
+        if ( ( valid != 0 ) && ( edge - last == 1 ) && ( seconds != previous ) )
+        {
+            rtc3_ctxGetSnapshot( ctx, &snapshot );
+
+            if ( ( snapshot.reg[ 0 ] & 0x7F ) == seconds )
+            {
+                rtc3_decodeSnapshot( &snapshot, &dateTime );
+                _subsecPublish( ctx, edge, rtc3_dateTimeToEpoch( &dateTime ) );
+
+                return 0;
+            }
+
+            valid = 0;
+            continue;
+        }
+
+        previous = seconds;
+        valid = 1;
+    }
 
-    rtc3_writeByte( _RTC3_REG_TIME_HOUR, temp );
+    return 1;
 }
 
-/* Get day of the week function */
-uint8_t rtc3_getDayOfTheWeek()
+static void _subsecPublish( rtc3_t *ctx, uint32_t edge, uint32_t epoch )
 {
-    uint8_t temp;
+    uint8_t  next;
+    uint8_t  anchor;
+    uint32_t span;
+    uint32_t elapsed;
+    int32_t  extra;
+    int32_t  bound;
+    int32_t  slip;
+
+    next = ctx->subsecPubIndex ^ 0x01;
+    slip = 0;
+    anchor = 1;
+
+    // The 512 Hz output is not calibrated, measure its rate against the
+    // seconds since the first lock and spread the difference over the edges
+    if ( ctx->subsecLocked != 0 )
+    {
+        span = edge - ctx->subsecRefEdge;
+        elapsed = epoch - ctx->subsecRefEpoch;
+        slip = ctx->subsecPubSlip[ ctx->subsecPubIndex ];
+
+        if ( elapsed < _RTC3_SUBSEC_REF_SECONDS )
+        {
+            extra = ( int32_t )( span - ( elapsed << _RTC3_SUBSEC_SHIFT ) );
+            bound = ( int32_t )( span >> _RTC3_SUBSEC_SLIP_SHIFT );
+
+            if ( ( extra <= bound ) && ( -extra <= bound ) )
+            {
+                slip = ( extra != 0 ) ? ( int32_t )span / extra : 0;
+                anchor = 0;
+            }
+            else
+            {
+                // Far beyond any crystal error, the time was set meanwhile
+                slip = 0;
+            }
+        }
+    }
 
-    temp = rtc3_readByte( _RTC3_REG_TIME_DAY_OF_THE_WEEK );
+    if ( anchor != 0 )
+    {
+        ctx->subsecRefEdge = edge;
+        ctx->subsecRefEpoch = epoch;
+    }
 
-    return temp;
+    ctx->subsecPubEpoch[ next ] = epoch;
+    ctx->subsecPubEdge[ next ] = edge;
+    ctx->subsecPubSlip[ next ] = slip;
+    ctx->subsecPubIndex = next;
+    ctx->subsecLocked = 1;
 }
+#endif
 
-/* Set day of the week function */
-void rtc3_setDayOfTheWeek( uint8_t wDay )
+static int32_t _calibrationPpb( uint8_t config1 )
 {
-    wDay %= 8;
+    uint32_t steps;
+
+    steps = config1 & 0x1F;
 
-    if ( wDay == 0 )
+    // 1e9 / 245760 = 12500000 / 3072, 1e9 / 491520 = 12500000 / 6144
+    if ( config1 & 0x20 )
     {
-        wDay = 1;
+        return -( int32_t )( ( steps * 12500000 ) / 3072 );
     }
-    rtc3_writeByte( _RTC3_REG_TIME_DAY_OF_THE_WEEK, wDay );
+
+    return ( int32_t )( ( steps * 12500000 ) / 6144 );
 }
 
-/* Get day function */
-uint8_t rtc3_getDateDay()
+static uint8_t _calibrationSelect( int32_t errorPpb )
 {
-    uint8_t ones;
-    uint8_t tens;
-    uint8_t result;
-    uint8_t temp;
+    uint8_t  calSign;
+    uint32_t magnitude;
+    uint32_t steps;
 
-    temp = rtc3_readByte( _RTC3_REG_TIME_DATE_DAY );
+    // Nearest step, negative steps are 1 / 245760, positive 1 / 491520
+    calSign = ( errorPpb > 0 ) ? 1 : 0;
+    magnitude = ( errorPpb > 0 ) ? ( uint32_t )errorPpb : ( uint32_t )( -errorPpb );
 
-    ones = temp & 0x0F;
+    if ( magnitude > 200000 )
+    {
+        magnitude = 200000;
+    }
 
-    tens = ( temp & 0x30 ) >> 4;
+    if ( calSign != 0 )
+    {
+        steps = ( magnitude * 3072 + 6250000 ) / 12500000;
+    }
+    else
+    {
+        steps = ( magnitude * 6144 + 6250000 ) / 12500000;
+    }
 
-    result = ( 10 * tens ) + ones;
+    if ( steps > 0x1F )
+    {
+        steps = 0x1F;
+    }
 
-    return result;
+    return ( calSign << 5 ) | ( uint8_t )steps;
 }
 
-/* Set day function */
-void rtc3_setDateDay( uint8_t dateDay )
+static int32_t _ratioPpb( int32_t diff, uint32_t total )
 {
-    uint8_t ones;
-    uint8_t tens;
-    uint8_t temp;
+    uint32_t rem;
+    uint32_t result;
+    uint8_t  cnt;
 
-    ones = 0x00;
-    tens = 0x00;
+    rem = ( diff < 0 ) ? ( uint32_t )( -diff ) : ( uint32_t )diff;
 
-    dateDay %= 32;
-
-    if ( dateDay == 0 )
+    // Keep rem * 10 inside 32 bits
+    while ( total > 0x19999999 )
     {
-        dateDay = 1;
+        total >>= 1;
+        rem >>= 1;
     }
 
-    ones = dateDay % 10;
+    if ( ( total == 0 ) || ( rem >= total ) )
+    {
+        return ( diff < 0 ) ? -1000000000 : 1000000000;
+    }
 
-    tens = ( dateDay / 10 ) << 4;
+    // diff * 1e9 / total, one decimal digit at a time
+    result = 0;
 
-    temp = tens | ones;
+    for ( cnt = 0; cnt < 9; cnt++ )
+    {
+        rem = ( rem << 3 ) + ( rem << 1 );
+        result = ( result << 3 ) + ( result << 1 ) + ( rem / total );
+        rem %= total;
+    }
 
-    rtc3_writeByte( _RTC3_REG_TIME_DATE_DAY, temp );
+    return ( diff < 0 ) ? -( int32_t )result : ( int32_t )result;
 }
 
-/* Get month function */
-uint8_t rtc3_getDateMonth()
+static uint8_t _waitRisingEdge( rtc3_t *ctx, rtc3_counter_t counter, uint32_t timeout, uint32_t *stamp )
 {
-    uint8_t ones;
-    uint8_t tens;
-    uint8_t result;
-    uint8_t temp;
+    uint32_t start;
+    uint8_t  pinLast;
+    uint8_t  pinState;
 
-    temp = rtc3_readByte( _RTC3_REG_TIME_DATE_MONTH );
+    start = counter();
+    pinLast = rtc3_ctxGetInterrupt( ctx );
 
-    ones = temp & 0x0F;
+    while ( ( counter() - start ) < timeout )
+    {
+        pinState = rtc3_ctxGetInterrupt( ctx );
 
-    tens = ( temp & 0x10 ) >> 4;
+        if ( ( pinState != 0 ) && ( pinLast == 0 ) )
+        {
+            *stamp = counter();
+            return 0;
+        }
 
-    result = ( 10 * tens ) + ones;
+        pinLast = pinState;
+    }
 
-    return result;
+    return 1;
 }
 
-/* Set month function */
-void rtc3_setDateMonth( uint8_t dateMonth )
+#ifdef __RTC3_ENABLE_ASYNC__
+static uint8_t _asyncBegin( rtc3_t *ctx, uint8_t read, uint8_t startReg, uint8_t nBytes, rtc3_done_t done )
 {
-    uint8_t ones;
-    uint8_t tens;
-    uint8_t temp;
+    if ( nBytes > _RTC3_BLOCK_SIZE_MAX )
+    {
+        nBytes = _RTC3_BLOCK_SIZE_MAX;
+    }
 
-    ones = 0x00;
-    tens = 0x00;
+    ctx->asyncRead = read;
+    ctx->asyncFrame[ 0 ] = startReg;
+    ctx->asyncCount = nBytes;
+    ctx->asyncIndex = 0;
+    ctx->asyncError = 0;
+    ctx->asyncDone = done;
 
-    dateMonth %= 13;
+#ifdef __HAL_I2C_DMA__
+    _ctxSelect( ctx );
 
-    if ( dateMonth == 0 )
+    // Whole transaction on DMA, the CPU is back only for the completion
+    ctx->asyncState = _RTC3_ASYNC_DMA;
+
+    if ( read )
     {
-        dateMonth = 1;
+        if ( hal_i2cDmaTransfer( ctx->slaveAddress, ctx->asyncFrame, 1, &ctx->asyncFrame[ 1 ], nBytes ) == 0 )
+        {
+            hal_statsAsyncBegin();
+            return 0;
+        }
+    }
+    else
+    {
+        if ( hal_i2cDmaTransfer( ctx->slaveAddress, ctx->asyncFrame, nBytes + 1, 0, 0 ) == 0 )
+        {
+            hal_statsAsyncBegin();
+            return 0;
+        }
     }
+#endif
 
-    ones = dateMonth % 10;
+#ifdef __HAL_I2C_ASYNC__
+    _ctxSelect( ctx );
 
-    tens = ( dateMonth / 10 ) << 4;
+    ctx->asyncState = _RTC3_ASYNC_START;
+    hal_statsAsyncBegin();
+    hal_i2cAsyncStart();
+#else
+    // No interrupt driven HAL, move the data now and report on the next poll
+    if ( read )
+    {
+        ctx->asyncError = rtc3_ctxReadBlock( ctx, startReg, &ctx->asyncFrame[ 1 ], nBytes );
+    }
+    else
+    {
+        ctx->asyncError = rtc3_ctxWriteBlock( ctx, startReg, &ctx->asyncFrame[ 1 ], nBytes );
+    }
 
-    temp = tens | ones;
+    ctx->asyncState = _RTC3_ASYNC_COMPLETE;
+#endif
 
-    rtc3_writeByte( _RTC3_REG_TIME_DATE_MONTH, temp );
+    return 0;
 }
 
-/* Get year function */
-uint8_t rtc3_getDateYear()
+#ifdef __HAL_I2C_ASYNC__
+static void _asyncStep( rtc3_t *ctx )
 {
-    uint8_t ones;
-    uint8_t tens;
     uint8_t result;
-    uint8_t temp;
-
-    temp = rtc3_readByte( _RTC3_REG_TIME_DATE_YEAR );
-
-    ones = temp & 0x0F;
 
-    tens = ( temp & 0xF0 ) >> 4;
+    result = hal_i2cAsyncResult();
 
-    result = ( 10 * tens ) + ones;
+    switch ( ctx->asyncState )
+    {
+        case _RTC3_ASYNC_START :
+            ctx->asyncState = _RTC3_ASYNC_ADDRESS_WRITE;
+            hal_i2cAsyncWrite( ctx->slaveAddress << 1 );
+            return;
+
+        case _RTC3_ASYNC_ADDRESS_WRITE :
+            if ( result == 0 )
+            {
+                break;
+            }
+            ctx->asyncState = _RTC3_ASYNC_POINTER;
+            hal_i2cAsyncWrite( ctx->asyncFrame[ 0 ] );
+            return;
+
+        case _RTC3_ASYNC_POINTER :
+            if ( result == 0 )
+            {
+                break;
+            }
+            if ( ctx->asyncRead )
+            {
+                ctx->asyncState = _RTC3_ASYNC_RESTART;
+                hal_i2cAsyncStart();
+                return;
+            }
+            ctx->asyncState = _RTC3_ASYNC_DATA;
+            if ( ctx->asyncCount == 0 )
+            {
+                ctx->asyncState = _RTC3_ASYNC_STOP;
+                hal_i2cAsyncStop();
+                return;
+            }
+            hal_i2cAsyncWrite( ctx->asyncFrame[ 1 + ctx->asyncIndex++ ] );
+            return;
+
+        case _RTC3_ASYNC_RESTART :
+            ctx->asyncState = _RTC3_ASYNC_ADDRESS_READ;
+            hal_i2cAsyncWrite( ( ctx->slaveAddress << 1 ) | 0x01 );
+            return;
+
+        case _RTC3_ASYNC_ADDRESS_READ :
+            if ( result == 0 )
+            {
+                break;
+            }
+            ctx->asyncState = _RTC3_ASYNC_DATA;
+            // Master ACKs every byte except the last one
+            hal_i2cAsyncRead( ctx->asyncCount > 1 );
+            return;
+
+        case _RTC3_ASYNC_DATA :
+            if ( ctx->asyncRead )
+            {
+                ctx->asyncFrame[ 1 + ctx->asyncIndex++ ] = result;
+                if ( ctx->asyncIndex < ctx->asyncCount )
+                {
+                    hal_i2cAsyncRead( ctx->asyncIndex + 1 < ctx->asyncCount );
+                    return;
+                }
+            }
+            else
+            {
+                if ( result == 0 )
+                {
+                    break;
+                }
+                if ( ctx->asyncIndex < ctx->asyncCount )
+                {
+                    hal_i2cAsyncWrite( ctx->asyncFrame[ 1 + ctx->asyncIndex++ ] );
+                    return;
+                }
+            }
+            ctx->asyncState = _RTC3_ASYNC_STOP;
+            hal_i2cAsyncStop();
+            return;
+
+        default :
+            ctx->asyncState = _RTC3_ASYNC_COMPLETE;
+            return;
+    }
 
-    return result;
+    // NACK, release the bus and report the error
+    ctx->asyncError = 1;
+    ctx->asyncState = _RTC3_ASYNC_STOP;
+    hal_i2cAsyncStop();
 }
+#endif
 
-/* Set year function */
-void rtc3_setDateYear( uint16_t dateYear )
+static void _asyncFinish( rtc3_t *ctx )
 {
-    uint8_t ones;
-    uint8_t tens;
-    uint8_t temp;
+    uint8_t     cnt;
+    rtc3_done_t done;
 
-    ones = 0x00;
-    tens = 0x00;
+    hal_statsAsyncEnd( ctx->asyncRead, ctx->asyncCount, ctx->asyncError );
 
-    dateYear %= 100;
+    if ( ctx->asyncError == 0 )
+    {
+        if ( ctx->asyncRead == 0 )
+        {
+            _shadowUpdate( ctx, ctx->asyncFrame[ 0 ], &ctx->asyncFrame[ 1 ], ctx->asyncCount );
+        }
+        else if ( ctx->asyncDateTime != 0 )
+        {
+            _dateTimeDecode( &ctx->asyncFrame[ 1 ], ctx->asyncDateTime );
+        }
+        else
+        {
+            for ( cnt = 0; cnt < ctx->asyncCount; cnt++ )
+            {
+                ctx->asyncDest[ cnt ] = ctx->asyncFrame[ 1 + cnt ];
+            }
+        }
+    }
 
-    ones = dateYear % 10;
+    done = ctx->asyncDone;
+    ctx->asyncState = _RTC3_ASYNC_IDLE;
 
-    tens = ( dateYear / 10 ) << 4;
+    if ( done != 0 )
+    {
+        done( ctx->asyncError );
+    }
+}
+#endif
 
-    temp = tens | ones;
+/* --------------------------------------------------------- PUBLIC FUNCTIONS */
 
-    rtc3_writeByte( _RTC3_REG_TIME_DATE_YEAR, temp );
-}
+#ifdef   __RTC3_DRV_SPI__
 
-/* Set time hours, minutes and seconds function */
-void rtc3_setTime( uint8_t timeHours, uint8_t timeMinutes, uint8_t timeSeconds )
+void rtc3_spiDriverInit(T_RTC3_P gpioObj, T_RTC3_P spiObj)
 {
-    rtc3_setTimeHours( timeHours );
-    rtc3_setTimeMinutes( timeMinutes );
-    rtc3_setTimeSeconds( timeSeconds );
+    hal_spiMap( (T_HAL_P)spiObj );
+    hal_gpioMap( (T_HAL_P)gpioObj );
+
+    // ... power ON
+    // ... configure CHIP
 }
 
-/* Get time hours, minutes and seconds function */
-void rtc3_getTime( uint8_t *timeHours, uint8_t *timeMinutes, uint8_t *timeSeconds )
+#endif
+#ifdef   __RTC3_DRV_I2C__
+
+void rtc3_i2cDriverInit(T_RTC3_P gpioObj, T_RTC3_P i2cObj, uint8_t slave)
 {
-    *timeHours = rtc3_getTimeHours();
-    *timeMinutes = rtc3_getTimeMinutes();
-    *timeSeconds = rtc3_getTimeSeconds();
+    rtc3_ctxI2cDriverInit( &_rtc3Default, gpioObj, i2cObj, slave );
 }
 
-/* Set date hours, minutes and seconds function */
-void rtc3_setDate( uint8_t dayOfTheWeek, uint8_t dateDay, uint8_t dateMonth, uint16_t dateYear )
+void rtc3_ctxI2cDriverInit(rtc3_t *ctx, T_RTC3_P gpioObj, T_RTC3_P i2cObj, uint8_t slave)
 {
-    rtc3_setDayOfTheWeek( dayOfTheWeek );
-    rtc3_setDateDay( dateDay );
-    rtc3_setDateMonth( dateMonth );
-    rtc3_setDateYear( dateYear );
+    ctx->gpioObj = gpioObj;
+    ctx->i2cObj = i2cObj;
+    ctx->slaveAddress = slave;
+
+    ctx->tickCallback = 0;
+    ctx->tickPending = 0;
+    ctx->pollValid = 0;
+#ifdef __RTC3_ENABLE_CLOCK__
+    ctx->clockRunning = 0;
+    ctx->clockCounter = 0;
+    ctx->clockSeq = 0;
+    ctx->clockSyncPending = 0;
+    ctx->clockResyncDue = 0;
+    ctx->clockPubIndex = 0;
+    ctx->clockPubEpoch[ 0 ] = 0;
+    ctx->clockPubStamp[ 0 ] = 0;
+#endif
+#ifdef __RTC3_ENABLE_SUBSEC__
+    ctx->subsecCounter = 0;
+    ctx->subsecEdges = 0;
+    ctx->subsecLocked = 0;
+    ctx->subsecPubIndex = 0;
+#endif
+#ifdef __RTC3_ENABLE_ASYNC__
+    ctx->asyncState = _RTC3_ASYNC_IDLE;
+#endif
+#ifdef __RTC3_ENABLE_EVENTS__
+    ctx->eventHead = 0;
+    ctx->eventTail = 0;
+    ctx->eventHighWater = 0;
+    ctx->eventOverflows = 0;
+#endif
+#ifdef __RTC3_ENABLE_TEMPCOMP__
+    ctx->tempCallback = 0;
+#endif
+
+    // Force the remap, the objects may have changed under the same instance
+    _rtc3Active = 0;
+    _ctxSelect( ctx );
+
+    rtc3_ctxSyncShadow( ctx );
 }
 
-/* Get time hours, minutes and seconds function */
-void rtc3_getDate( uint8_t *dayOfTheWeek, uint8_t *dateDay, uint8_t *dateMonth, uint16_t *dateYear )
+#endif
+#ifdef   __RTC3_DRV_UART__
+
+void rtc3_uartDriverInit(T_RTC3_P gpioObj, T_RTC3_P uartObj)
 {
-    *dayOfTheWeek = rtc3_getDayOfTheWeek();
-    *dateDay = rtc3_getDateDay();
-    *dateMonth = rtc3_getDateMonth();
-    *dateYear = rtc3_getDateYear();
+    hal_uartMap( (T_HAL_P)uartObj );
+    hal_gpioMap( (T_HAL_P)gpioObj );
+
+    // ... power ON
+    // ... configure CHIP
 }
 
-/* Set calibration function */
-void rtc3_setCalibration( uint8_t calSign, uint8_t calNumber )
+#endif
+
+
+
+/* ----------------------------------------------------------- IMPLEMENTATION */
+
+
+
+/* Generic read byte of data function */
+uint8_t rtc3_ctxReadByte( rtc3_t *ctx, uint8_t regAddress )
 {
-    uint8_t temp;
-    
-    temp = _RTC3_CONFIG1_INITIAL;
-    
-    temp |= calSign << 5;
-    temp |= calNumber;
-    
-    rtc3_writeByte( _RTC3_REG_CONFIG1, temp );
+    uint8_t rBuffer[ 1 ];
+
+    rtc3_ctxReadBlock( ctx, regAddress, rBuffer, 1 );
+
+    return rBuffer[ 0 ];
 }
 
-/* Set trickle charge control function */
-void rtc3_setTrickleCharge( uint8_t tch2 )
+/* Generic write byte of data function */
+void rtc3_ctxWriteByte( rtc3_t *ctx, uint8_t regAddress, uint8_t writeData )
 {
-    uint8_t temp;
+    rtc3_ctxWriteBlock( ctx, regAddress, &writeData, 1 );
+}
+
+/* Generic burst read function */
+uint8_t rtc3_ctxReadBlock( rtc3_t *ctx, uint8_t startReg, uint8_t *pBuf, uint8_t nBytes )
+{
+    uint8_t wBuffer[ 1 ];
+    uint8_t error;
 
-    temp = rtc3_readByte( _RTC3_REG_TRICKLE_CHARGE2 );
+    wBuffer[ 0 ] = startReg;
+    error = 0;
 
-    if ( tch2 == 0 )
+    hal_statsCallBegin();
+
+    // Every stage runs, so the HAL always closes the transaction with a STOP
+    _ctxSelect( ctx );
+    if ( hal_i2cStart() != 0 )
     {
-        temp |= _RTC3_TCH2_OPEN;
+        error = 1;
+    }
+    if ( hal_i2cWrite( ctx->slaveAddress, wBuffer, 1, END_MODE_RESTART ) != 0 )
+    {
+        error = 1;
+    }
+    if ( hal_i2cRead( ctx->slaveAddress, pBuf, nBytes, END_MODE_STOP ) != 0 )
+    {
+        error = 1;
     }
 
-    if ( tch2 == 1 )
+    hal_statsCallEnd();
+
+    return error;
+}
+
+/* Generic burst write function */
+uint8_t rtc3_ctxWriteBlock( rtc3_t *ctx, uint8_t startReg, uint8_t *pBuf, uint8_t nBytes )
+{
+    uint8_t wBuffer[ _RTC3_BLOCK_SIZE_MAX + 1 ];
+    uint8_t cnt;
+    uint8_t error;
+
+    if ( nBytes > _RTC3_BLOCK_SIZE_MAX )
     {
-        temp |= _RTC3_TCH2_CLOSED;
+        nBytes = _RTC3_BLOCK_SIZE_MAX;
+    }
+
+    wBuffer[ 0 ] = startReg;
+
+    for ( cnt = 0; cnt < nBytes; cnt++ )
+    {
+        wBuffer[ cnt + 1 ] = pBuf[ cnt ];
+    }
+
+    error = 0;
+
+    hal_statsCallBegin();
+
+    _ctxSelect( ctx );
+    if ( hal_i2cStart() != 0 )
+    {
+        error = 1;
+    }
+    if ( hal_i2cWrite( ctx->slaveAddress, wBuffer, nBytes + 1, END_MODE_STOP ) != 0 )
+    {
+        error = 1;
+    }
+
+    hal_statsCallEnd();
+
+    // The shadows follow only what the chip acknowledged
+    if ( error == 0 )
+    {
+        _shadowUpdate( ctx, startReg, pBuf, nBytes );
     }
 
-    rtc3_writeByte( _RTC3_REG_TRICKLE_CHARGE2, temp );
+    return error;
 }
 
-/* Set trickle charge bypass control function */
-void rtc3_setTrickleChargeBypass( uint8_t tcfe )
+/* Synchronize configuration shadow registers function */
+void rtc3_ctxSyncShadow( rtc3_t *ctx )
+{
+    uint8_t rBuffer[ 4 ];
+
+    hal_statsCallBegin();
+
+    // Shadows are kept as they were unless both reads went through
+    if ( ( rtc3_ctxReadBlock( ctx, _RTC3_REG_CONFIG1, rBuffer, 3 ) == 0 ) &&
+         ( rtc3_ctxReadBlock( ctx, _RTC3_REG_SFR, &rBuffer[ 3 ], 1 ) == 0 ) )
+    {
+        ctx->shadowConfig1 = rBuffer[ 0 ];
+        ctx->shadowTrickleCharge2 = rBuffer[ 1 ];
+        ctx->shadowConfig2 = rBuffer[ 2 ];
+        ctx->shadowSfr = rBuffer[ 3 ];
+    }
+
+    hal_statsCallEnd();
+}
+
+/* Enable counting function */
+void rtc3_ctxEnableCounting( rtc3_t *ctx )
 {
     uint8_t temp;
 
-    temp = rtc3_readByte( _RTC3_REG_CONFIG2 );
+    hal_statsCallBegin();
 
-    if ( tcfe == 0 )
+    temp = rtc3_ctxReadByte( ctx, _RTC3_REG_TIME_SEC );
+
+    temp &= 0x7F;
+
+    rtc3_ctxWriteByte( ctx, _RTC3_REG_TIME_SEC, temp );
+
+    hal_statsCallEnd();
+}
+
+/* Disable counting function */
+void rtc3_ctxDisableCounting( rtc3_t *ctx )
+{
+    uint8_t temp;
+
+    hal_statsCallBegin();
+
+    temp = rtc3_ctxReadByte( ctx, _RTC3_REG_TIME_SEC );
+
+    temp |= 0x80;
+
+    rtc3_ctxWriteByte( ctx, _RTC3_REG_TIME_SEC, temp );
+
+    hal_statsCallEnd();
+}
+
+/* Get seconds function */
+uint8_t rtc3_ctxGetTimeSeconds( rtc3_t *ctx )
+{
+    return _fieldDecode( _RTC3_REG_TIME_SEC, rtc3_ctxReadByte( ctx, _RTC3_REG_TIME_SEC ) );
+}
+
+/* Set seconds function */
+void rtc3_ctxSetTimeSeconds( rtc3_t *ctx, uint8_t seconds )
+{
+    rtc3_ctxWriteByte( ctx, _RTC3_REG_TIME_SEC, _fieldEncode( _RTC3_REG_TIME_SEC, seconds ) );
+}
+
+/* Get minutes function */
+uint8_t rtc3_ctxGetTimeMinutes( rtc3_t *ctx )
+{
+    return _fieldDecode( _RTC3_REG_TIME_MIN, rtc3_ctxReadByte( ctx, _RTC3_REG_TIME_MIN ) );
+}
+
+/* Set minutes function */
+void rtc3_ctxSetTimeMinutes( rtc3_t *ctx, uint8_t minutes )
+{
+    rtc3_ctxWriteByte( ctx, _RTC3_REG_TIME_MIN, _fieldEncode( _RTC3_REG_TIME_MIN, minutes ) );
+}
+
+/* Get hours function */
+uint8_t rtc3_ctxGetTimeHours( rtc3_t *ctx )
+{
+    return _fieldDecode( _RTC3_REG_TIME_HOUR, rtc3_ctxReadByte( ctx, _RTC3_REG_TIME_HOUR ) );
+}
+
+/* Set hours function */
+void rtc3_ctxSetTimeHours( rtc3_t *ctx, uint8_t hours )
+{
+    rtc3_ctxWriteByte( ctx, _RTC3_REG_TIME_HOUR, _fieldEncode( _RTC3_REG_TIME_HOUR, hours ) );
+}
+
+/* Get day of the week function */
+uint8_t rtc3_ctxGetDayOfTheWeek( rtc3_t *ctx )
+{
+    return _fieldDecode( _RTC3_REG_TIME_DAY_OF_THE_WEEK, rtc3_ctxReadByte( ctx, _RTC3_REG_TIME_DAY_OF_THE_WEEK ) );
+}
+
+/* Set day of the week function */
+void rtc3_ctxSetDayOfTheWeek( rtc3_t *ctx, uint8_t wDay )
+{
+    rtc3_ctxWriteByte( ctx, _RTC3_REG_TIME_DAY_OF_THE_WEEK, _fieldEncode( _RTC3_REG_TIME_DAY_OF_THE_WEEK, wDay ) );
+}
+
+/* Get day function */
+uint8_t rtc3_ctxGetDateDay( rtc3_t *ctx )
+{
+    return _fieldDecode( _RTC3_REG_TIME_DATE_DAY, rtc3_ctxReadByte( ctx, _RTC3_REG_TIME_DATE_DAY ) );
+}
+
+/* Set day function */
+void rtc3_ctxSetDateDay( rtc3_t *ctx, uint8_t dateDay )
+{
+    rtc3_ctxWriteByte( ctx, _RTC3_REG_TIME_DATE_DAY, _fieldEncode( _RTC3_REG_TIME_DATE_DAY, dateDay ) );
+}
+
+/* Get month function */
+uint8_t rtc3_ctxGetDateMonth( rtc3_t *ctx )
+{
+    return _fieldDecode( _RTC3_REG_TIME_DATE_MONTH, rtc3_ctxReadByte( ctx, _RTC3_REG_TIME_DATE_MONTH ) );
+}
+
+/* Set month function */
+void rtc3_ctxSetDateMonth( rtc3_t *ctx, uint8_t dateMonth )
+{
+    rtc3_ctxWriteByte( ctx, _RTC3_REG_TIME_DATE_MONTH, _fieldEncode( _RTC3_REG_TIME_DATE_MONTH, dateMonth ) );
+}
+
+/* Get year function */
+uint8_t rtc3_ctxGetDateYear( rtc3_t *ctx )
+{
+    return _fieldDecode( _RTC3_REG_TIME_DATE_YEAR, rtc3_ctxReadByte( ctx, _RTC3_REG_TIME_DATE_YEAR ) );
+}
+
+/* Set year function */
+void rtc3_ctxSetDateYear( rtc3_t *ctx, uint16_t dateYear )
+{
+    rtc3_ctxWriteByte( ctx, _RTC3_REG_TIME_DATE_YEAR, _yearEncode( dateYear ) );
+}
+
+/* Set time hours, minutes and seconds function */
+void rtc3_ctxSetTime( rtc3_t *ctx, uint8_t timeHours, uint8_t timeMinutes, uint8_t timeSeconds )
+{
+    uint8_t wBuffer[ 3 ];
+
+    wBuffer[ 0 ] = _fieldEncode( _RTC3_REG_TIME_SEC, timeSeconds );
+    wBuffer[ 1 ] = _fieldEncode( _RTC3_REG_TIME_MIN, timeMinutes );
+    wBuffer[ 2 ] = _fieldEncode( _RTC3_REG_TIME_HOUR, timeHours );
+
+    rtc3_ctxWriteBlock( ctx, _RTC3_REG_TIME_SEC, wBuffer, 3 );
+}
+
+/* Get time hours, minutes and seconds function */
+void rtc3_ctxGetTime( rtc3_t *ctx, uint8_t *timeHours, uint8_t *timeMinutes, uint8_t *timeSeconds )
+{
+    uint8_t rBuffer[ 3 ];
+
+    rtc3_ctxReadBlock( ctx, _RTC3_REG_TIME_SEC, rBuffer, 3 );
+
+    *timeSeconds = _fieldDecode( _RTC3_REG_TIME_SEC, rBuffer[ 0 ] );
+    *timeMinutes = _fieldDecode( _RTC3_REG_TIME_MIN, rBuffer[ 1 ] );
+    *timeHours = _fieldDecode( _RTC3_REG_TIME_HOUR, rBuffer[ 2 ] );
+}
+
+/* Set date hours, minutes and seconds function */
+void rtc3_ctxSetDate( rtc3_t *ctx, uint8_t dayOfTheWeek, uint8_t dateDay, uint8_t dateMonth, uint16_t dateYear )
+{
+    uint8_t wBuffer[ 4 ];
+
+    wBuffer[ 0 ] = _fieldEncode( _RTC3_REG_TIME_DAY_OF_THE_WEEK, dayOfTheWeek );
+    wBuffer[ 1 ] = _fieldEncode( _RTC3_REG_TIME_DATE_DAY, dateDay );
+    wBuffer[ 2 ] = _fieldEncode( _RTC3_REG_TIME_DATE_MONTH, dateMonth );
+    wBuffer[ 3 ] = _yearEncode( dateYear );
+
+    rtc3_ctxWriteBlock( ctx, _RTC3_REG_TIME_DAY_OF_THE_WEEK, wBuffer, 4 );
+}
+
+/* Get time hours, minutes and seconds function */
+void rtc3_ctxGetDate( rtc3_t *ctx, uint8_t *dayOfTheWeek, uint8_t *dateDay, uint8_t *dateMonth, uint16_t *dateYear )
+{
+    uint8_t rBuffer[ 4 ];
+
+    rtc3_ctxReadBlock( ctx, _RTC3_REG_TIME_DAY_OF_THE_WEEK, rBuffer, 4 );
+
+    *dayOfTheWeek = _fieldDecode( _RTC3_REG_TIME_DAY_OF_THE_WEEK, rBuffer[ 0 ] );
+    *dateDay = _fieldDecode( _RTC3_REG_TIME_DATE_DAY, rBuffer[ 1 ] );
+    *dateMonth = _fieldDecode( _RTC3_REG_TIME_DATE_MONTH, rBuffer[ 2 ] );
+    *dateYear = _fieldDecode( _RTC3_REG_TIME_DATE_YEAR, rBuffer[ 3 ] );
+}
+
+/* Set date and time function */
+void rtc3_ctxSetDateTime( rtc3_t *ctx, rtc3_datetime_t *dateTime )
+{
+    uint8_t wBuffer[ 7 ];
+
+    _dateTimeEncode( dateTime, wBuffer );
+
+    rtc3_ctxWriteBlock( ctx, _RTC3_REG_TIME_SEC, wBuffer, 7 );
+}
+
+/* Set date and time on a reference second function */
+uint8_t rtc3_ctxSetDateTimeAligned( rtc3_t *ctx, rtc3_datetime_t *dateTime, rtc3_counter_t counter, uint32_t counterHz, uint32_t refStamp, uint32_t *latency )
+{
+    rtc3_datetime_t target;
+    uint8_t  wBuffer[ 7 ];
+    uint32_t start;
+    uint32_t elapsed;
+    uint32_t seconds;
+    uint32_t fire;
+    uint8_t  cnt;
+
+    // Every age up to the write, one second past the oldest, fits 32 bits
+    if ( ( counterHz == 0 ) || ( counterHz > 0xFFFFFFFFUL / ( _RTC3_ALIGN_MAX_AGE + 2 ) ) )
     {
-        temp |= _RTC3_TCFE_OPEN;
+        return 1;
     }
 
-    if ( tcfe == 1 )
+    hal_statsCallBegin();
+
+    // A seconds read changes nothing on the chip, even with stale shadows :
+    // address, pointer, address and one data byte, the real write reaches
+    // its seconds byte after three of those four bytes
+    *latency = 0xFFFFFFFFUL;
+
+    for ( cnt = 0; cnt < _RTC3_ALIGN_PROBES; cnt++ )
     {
-        temp |= _RTC3_TCFE_CLOSED;
+        start = counter();
+        rtc3_ctxReadByte( ctx, _RTC3_REG_TIME_SEC );
+        elapsed = counter() - start;
+
+        if ( elapsed < *latency )
+        {
+            *latency = elapsed;
+        }
+    }
+
+    *latency -= *latency >> 2;
+
+    // A refStamp in the future wraps to a huge age, a counter standing
+    // still over a bus write cannot time it
+    elapsed = counter() - refStamp;
+
+    if ( ( elapsed > _RTC3_ALIGN_MAX_AGE * counterHz ) || ( *latency == 0 ) || ( *latency >= counterHz ) )
+    {
+        hal_statsCallEnd();
+        return 1;
     }
 
-    rtc3_writeByte( _RTC3_REG_CONFIG2, temp );
+    // First reference second still ahead once the write is under way
+    seconds = ( elapsed + *latency ) / counterHz + 1;
+
+    rtc3_epochToDateTime( rtc3_dateTimeToEpoch( dateTime ) + seconds, &target );
+    _dateTimeEncode( &target, wBuffer );
+
+    // At most one second of counter ticks from here
+    fire = seconds * counterHz - *latency;
+
+    while ( counter() - refStamp < fire );
+
+    // The seconds write restarts the countdown chain as its byte lands
+    rtc3_ctxWriteBlock( ctx, _RTC3_REG_TIME_SEC, wBuffer, 7 );
+
+    hal_statsCallEnd();
+
+    return 0;
 }
 
-/* Set special function key byte 1 function */
-void rtc3_setSpecialFunctionKey1( uint8_t sfkey1 )
+/* Get date and time function */
+void rtc3_ctxGetDateTime( rtc3_t *ctx, rtc3_datetime_t *dateTime )
 {
-    rtc3_writeByte( _RTC3_REG_SF_KEY1, sfkey1 );
+    uint8_t rBuffer[ 7 ];
+
+    rtc3_ctxReadBlock( ctx, _RTC3_REG_TIME_SEC, rBuffer, 7 );
+
+    _dateTimeDecode( rBuffer, dateTime );
 }
 
-/* Set special function key byte 2 function */
-void rtc3_setSpecialFunctionKey2( uint8_t sfkey2 )
+/* Poll date and time for a change function */
+uint8_t rtc3_ctxPollChanged( rtc3_t *ctx, rtc3_datetime_t *dateTime )
 {
-    rtc3_writeByte( _RTC3_REG_SF_KEY2, sfkey2 );
+    uint8_t rBuffer[ 7 ];
+    uint8_t nBytes;
+    uint8_t reach;
+    uint8_t cnt;
+
+    hal_statsCallBegin();
+
+    if ( ctx->pollValid == 0 )
+    {
+        nBytes = 7;
+        rtc3_ctxReadBlock( ctx, _RTC3_REG_TIME_SEC, rBuffer, nBytes );
+    }
+    else
+    {
+        nBytes = 1;
+        rBuffer[ 0 ] = rtc3_ctxReadByte( ctx, _RTC3_REG_TIME_SEC );
+
+        if ( rBuffer[ 0 ] == ctx->pollSnapshot.reg[ 0 ] )
+        {
+            hal_statsCallEnd();
+            return 0;
+        }
+    }
+
+    // A field below its last value rolled over, re-read from seconds up to what it reached
+    for ( ; ; )
+    {
+        reach = nBytes - 1;
+
+        for ( cnt = 0; cnt < nBytes; cnt++ )
+        {
+            if ( ( ( rBuffer[ cnt ] & _fieldMask[ cnt ] ) < ( ctx->pollSnapshot.reg[ cnt ] & _fieldMask[ cnt ] ) ) &&
+                 ( _fieldCarry[ cnt ] > reach ) )
+            {
+                reach = _fieldCarry[ cnt ];
+            }
+        }
+
+        if ( reach < nBytes )
+        {
+            break;
+        }
+
+        nBytes = reach + 1;
+        rtc3_ctxReadBlock( ctx, _RTC3_REG_TIME_SEC, rBuffer, nBytes );
+    }
+
+    hal_statsCallEnd();
+
+    for ( cnt = 0; cnt < nBytes; cnt++ )
+    {
+        ctx->pollSnapshot.reg[ cnt ] = rBuffer[ cnt ];
+    }
+
+    ctx->pollValid = 1;
+    _dateTimeDecode( ctx->pollSnapshot.reg, dateTime );
+
+    return 1;
 }
 
-/* Set frequency calibration control function */
-void rtc3_setFrequencyCalibration( uint8_t ftf )
+/* Date and time to epoch function */
+uint32_t rtc3_dateTimeToEpoch( rtc3_datetime_t *dateTime )
 {
-    if ( ftf == 0 )
+    uint16_t dateYear;
+
+    dateYear = dateTime->dateYear;
+    if ( dateYear >= 2000 )
+    {
+        dateYear -= 2000;
+    }
+    if ( dateYear > 99 )
     {
-        rtc3_writeByte( _RTC3_REG_SFR, _RTC3_FTF_NORMAL_512_HZ);
+        dateYear = 99;
     }
 
-    if ( ftf == 1 )
+    return _epochFromFields( dateYear, dateTime->dateMonth, dateTime->dateDay,
+                             dateTime->timeHours, dateTime->timeMinutes, dateTime->timeSeconds );
+}
+
+/* Epoch to date and time function */
+void rtc3_epochToDateTime( uint32_t epoch, rtc3_datetime_t *dateTime )
+{
+    uint32_t secondOfDay;
+    uint16_t days;
+    uint16_t cycleDay;
+    uint16_t dayOfYear;
+    uint8_t  yearOfCycle;
+    uint8_t  marchMonth;
+    uint16_t year;
+
+    if ( epoch < _RTC3_EPOCH_MIN )
+    {
+        epoch = _RTC3_EPOCH_MIN;
+    }
+    if ( epoch > _RTC3_EPOCH_MAX )
+    {
+        epoch = _RTC3_EPOCH_MAX;
+    }
+
+    days = epoch / 86400;
+    secondOfDay = epoch - (uint32_t)days * 86400;
+
+    dateTime->timeHours = secondOfDay / 3600;
+    secondOfDay -= (uint16_t)dateTime->timeHours * 3600;
+    dateTime->timeMinutes = (uint16_t)secondOfDay / 60;
+    dateTime->timeSeconds = (uint16_t)secondOfDay - (uint16_t)dateTime->timeMinutes * 60;
+
+    // 1970-01-01 was a Thursday
+    dateTime->dayOfTheWeek = ( days + 3 ) % 7 + 1;
+
+    // Days since 1996-03-01, split into 4-year cycles ending with the leap day
+    days -= 9556;
+    cycleDay = days % 1461;
+    yearOfCycle = ( cycleDay - cycleDay / 1460 ) / 365;
+    dayOfYear = cycleDay - 365 * yearOfCycle;
+
+    marchMonth = ( 5 * dayOfYear + 2 ) / 153;
+    dateTime->dateDay = dayOfYear - ( 153 * marchMonth + 2 ) / 5 + 1;
+
+    year = 1996 + ( days / 1461 ) * 4 + yearOfCycle;
+    if ( marchMonth < 10 )
+    {
+        dateTime->dateMonth = marchMonth + 3;
+    }
+    else
     {
-        rtc3_writeByte( _RTC3_REG_SFR, _RTC3_FTF_1_HZ);
+        dateTime->dateMonth = marchMonth - 9;
+        year++;
     }
+
+    dateTime->dateYear = year - 2000;
 }
 
-/* Get state of interrupt pin function */
-uint8_t rtc3_getInterrupt()
+/* Get epoch function */
+uint32_t rtc3_ctxGetEpoch( rtc3_t *ctx )
 {
-    return hal_gpio_intGet();
+    uint8_t rBuffer[ 7 ];
+
+    rtc3_ctxReadBlock( ctx, _RTC3_REG_TIME_SEC, rBuffer, 7 );
+
+    return _epochFromFields( _fieldDecode( _RTC3_REG_TIME_DATE_YEAR, rBuffer[ 6 ] ),
+                             _fieldDecode( _RTC3_REG_TIME_DATE_MONTH, rBuffer[ 5 ] ),
+                             _fieldDecode( _RTC3_REG_TIME_DATE_DAY, rBuffer[ 4 ] ),
+                             _fieldDecode( _RTC3_REG_TIME_HOUR, rBuffer[ 2 ] ),
+                             _fieldDecode( _RTC3_REG_TIME_MIN, rBuffer[ 1 ] ),
+                             _fieldDecode( _RTC3_REG_TIME_SEC, rBuffer[ 0 ] ) );
+}
+
+/* Set epoch function */
+void rtc3_ctxSetEpoch( rtc3_t *ctx, uint32_t epoch )
+{
+    rtc3_datetime_t dateTime;
+
+    rtc3_epochToDateTime( epoch, &dateTime );
+    rtc3_ctxSetDateTime( ctx, &dateTime );
 }
 
+/* Get raw date and time snapshot function */
+void rtc3_ctxGetSnapshot( rtc3_t *ctx, rtc3_snapshot_t *snapshot )
+{
+    rtc3_ctxReadBlock( ctx, _RTC3_REG_TIME_SEC, snapshot->reg, 7 );
+}
+
+/* Decode raw date and time snapshot function */
+void rtc3_decodeSnapshot( rtc3_snapshot_t *snapshot, rtc3_datetime_t *dateTime )
+{
+    _dateTimeDecode( snapshot->reg, dateTime );
+}
+
+/* Format ISO 8601 date and time function */
+uint8_t rtc3_formatIso8601( rtc3_snapshot_t *snapshot, char *pBuf )
+{
+    // YYYY-MM-DDThh:mm:ss, the chip counts years 2000 - 2099
+    pBuf[ 0 ] = '2';
+    pBuf[ 1 ] = '0';
+    _formatBcd( &pBuf[ 2 ], snapshot->reg[ 6 ] );
+    pBuf[ 4 ] = '-';
+    _formatBcd( &pBuf[ 5 ], snapshot->reg[ 5 ] & _fieldMask[ 5 ] );
+    pBuf[ 7 ] = '-';
+    _formatBcd( &pBuf[ 8 ], snapshot->reg[ 4 ] & _fieldMask[ 4 ] );
+    pBuf[ 10 ] = 'T';
+    _formatBcd( &pBuf[ 11 ], snapshot->reg[ 2 ] & _fieldMask[ 2 ] );
+    pBuf[ 13 ] = ':';
+    _formatBcd( &pBuf[ 14 ], snapshot->reg[ 1 ] & _fieldMask[ 1 ] );
+    pBuf[ 16 ] = ':';
+    _formatBcd( &pBuf[ 17 ], snapshot->reg[ 0 ] & _fieldMask[ 0 ] );
+    pBuf[ 19 ] = 0;
+
+    return 19;
+}
+
+/* Format custom date and time function */
+uint8_t rtc3_formatCustom( rtc3_snapshot_t *snapshot, char *format, char *pBuf, uint8_t bufSize )
+{
+    uint8_t len;
+    uint8_t regAddress;
+    uint8_t wDay;
+    uint8_t cnt;
+    char    spec;
+
+    if ( bufSize == 0 )
+    {
+        return 0;
+    }
+
+    len = 0;
+
+    // Two characters of headroom keep every field write in bounds
+    while ( ( *format != 0 ) && ( len + 2 < bufSize ) )
+    {
+        if ( *format != '%' )
+        {
+            pBuf[ len++ ] = *format++;
+            continue;
+        }
+
+        spec = format[ 1 ];
+        if ( spec == 0 )
+        {
+            break;
+        }
+        format += 2;
+
+        if ( ( spec == 'Y' ) && ( len + 4 >= bufSize ) )
+        {
+            break;
+        }
+
+        switch ( spec )
+        {
+            case 'S' : regAddress = _RTC3_REG_TIME_SEC;        break;
+            case 'M' : regAddress = _RTC3_REG_TIME_MIN;        break;
+            case 'H' : regAddress = _RTC3_REG_TIME_HOUR;       break;
+            case 'd' : regAddress = _RTC3_REG_TIME_DATE_DAY;   break;
+            case 'm' : regAddress = _RTC3_REG_TIME_DATE_MONTH; break;
+            case 'y' : regAddress = _RTC3_REG_TIME_DATE_YEAR;  break;
+
+            case 'Y' :
+                pBuf[ len++ ] = '2';
+                pBuf[ len++ ] = '0';
+                regAddress = _RTC3_REG_TIME_DATE_YEAR;
+                break;
+
+            case 'a' :
+            case 'A' :
+                wDay = ( snapshot->reg[ 3 ] & _fieldMask[ 3 ] ) - 1;
+                if ( wDay > 6 )
+                {
+                    pBuf[ len++ ] = '?';
+                    continue;
+                }
+                for ( cnt = 0; ( _weekdayName[ wDay ][ cnt ] != 0 ) && ( len + 1 < bufSize ); cnt++ )
+                {
+                    if ( ( spec == 'a' ) && ( cnt == 3 ) )
+                    {
+                        break;
+                    }
+                    pBuf[ len++ ] = _weekdayName[ wDay ][ cnt ];
+                }
+                continue;
+
+            default :
+                pBuf[ len++ ] = spec;
+                continue;
+        }
+
+        _formatBcd( &pBuf[ len ], snapshot->reg[ regAddress ] & _fieldMask[ regAddress ] );
+        len += 2;
+    }
+
+    pBuf[ len ] = 0;
+
+    return len;
+}
+
+/* Set calibration function */
+void rtc3_ctxSetCalibration( rtc3_t *ctx, uint8_t calSign, uint8_t calNumber )
+{
+    uint8_t temp;
+
+    // OUT and FT bits are kept from the shadow
+    temp = ctx->shadowConfig1 & 0xC0;
+
+    temp |= ( calSign & 0x01 ) << 5;
+    temp |= calNumber & 0x1F;
+
+    rtc3_ctxWriteByte( ctx, _RTC3_REG_CONFIG1, temp );
+}
+
+/* Automatic calibration function */
+uint8_t rtc3_ctxAutoCalibrate( rtc3_t *ctx, rtc3_counter_t counter, uint32_t counterHz, uint8_t ftf, uint16_t periods, rtc3_calibration_t *result )
+{
+    uint8_t  config1;
+    uint8_t  sfr;
+    uint8_t  calBits;
+    uint32_t outputHz;
+    uint32_t timeout;
+    uint32_t expected;
+    uint32_t first;
+    uint32_t last;
+    uint32_t measured;
+    uint16_t cnt;
+    uint8_t  error;
+    int32_t  errorPpb;
+
+    config1 = ctx->shadowConfig1;
+    sfr = ctx->shadowSfr;
+    outputHz = ( ftf == _RTC3_FTF_1_HZ ) ? 1 : 512;
+
+    // Two periods without an edge means the output is not running
+    timeout = ( counterHz / outputHz ) << 1;
+
+    hal_statsCallBegin();
+
+    rtc3_ctxEnableCalibrationOutput( ctx, ftf );
+
+    error = _waitRisingEdge( ctx, counter, timeout, &first );
+    last = first;
+
+    for ( cnt = 0; ( cnt < periods ) && ( error == 0 ); cnt++ )
+    {
+        error = _waitRisingEdge( ctx, counter, timeout, &last );
+    }
+
+    // Put the IRQ pin output back the way it was
+    if ( ( ( sfr ^ ftf ) & 0x01 ) != 0 )
+    {
+        rtc3_ctxSetSpecialFunctionKey1( ctx, _RTC3_SF_KEY1_VALUE );
+        rtc3_ctxSetSpecialFunctionKey2( ctx, _RTC3_SF_KEY2_VALUE );
+        rtc3_ctxSetFrequencyCalibration( ctx, sfr & 0x01 );
+    }
+
+    if ( error != 0 )
+    {
+        rtc3_ctxWriteByte( ctx, _RTC3_REG_CONFIG1, config1 );
+        hal_statsCallEnd();
+        return 1;
+    }
+
+    measured = last - first;
+
+    // periods * counterHz / outputHz, split so it cannot overflow
+    expected = ( counterHz / outputHz ) * periods + ( ( counterHz % outputHz ) * periods ) / outputHz;
+
+    // A fast crystal takes fewer reference ticks than expected
+    errorPpb = _ratioPpb( ( int32_t )( expected - measured ), measured );
+
+    // The 1 Hz output already carries the current CAL bits
+    if ( ftf == _RTC3_FTF_1_HZ )
+    {
+        errorPpb -= _calibrationPpb( config1 );
+    }
+
+    calBits = _calibrationSelect( errorPpb );
+
+    // OUT and FT as before, new CAL bits
+    rtc3_ctxWriteByte( ctx, _RTC3_REG_CONFIG1, ( config1 & 0xC0 ) | calBits );
+
+    hal_statsCallEnd();
+
+    if ( result != 0 )
+    {
+        result->errorPpb = errorPpb;
+        result->residualPpb = errorPpb + _calibrationPpb( calBits );
+        result->measuredTicks = measured;
+        result->calSign = calBits >> 5;
+        result->calNumber = calBits & 0x1F;
+    }
+
+    return 0;
+}
+
+#ifdef __RTC3_ENABLE_TEMPCOMP__
+/* Crystal temperature drift function */
+int32_t rtc3_tempCompDrift( int16_t temperature )
+{
+    uint8_t index;
+    int16_t fraction;
+    int32_t drift;
+
+    if ( temperature < _RTC3_TC_TEMP_MIN )
+    {
+        temperature = _RTC3_TC_TEMP_MIN;
+    }
+
+    if ( temperature > _RTC3_TC_TEMP_MAX )
+    {
+        temperature = _RTC3_TC_TEMP_MAX;
+    }
+
+    temperature -= _RTC3_TC_TEMP_MIN;
+    index = ( uint8_t )( temperature / 10 );
+    fraction = temperature - ( int16_t )index * 10;
+
+    // Linear between the 1 degree points, table is in 10 ppb units
+    drift = _tcDrift[ index ] + ( ( ( int32_t )_tcDrift[ index + 1 ] - _tcDrift[ index ] ) * fraction ) / 10;
+
+    return drift * 10;
+}
+
+/* Crystal offset at turnover function */
+int32_t rtc3_tempCompOffset( int32_t errorPpb, int16_t temperature )
+{
+    return errorPpb - rtc3_tempCompDrift( temperature );
+}
+
+/* Temperature compensation init function */
+void rtc3_ctxTempCompInit( rtc3_t *ctx, rtc3_temperature_t temperature, int32_t offsetPpb, uint16_t period )
+{
+    ctx->tempCallback = temperature;
+    ctx->tempOffsetPpb = offsetPpb;
+    ctx->tempPeriod = ( period != 0 ) ? period : 1;
+    ctx->tempCountdown = 1;
+}
+
+/* Temperature compensation service function */
+uint8_t rtc3_ctxTempCompService( rtc3_t *ctx )
+{
+    uint8_t calBits;
+
+    if ( ctx->tempCallback == 0 )
+    {
+        return 0;
+    }
+
+    if ( --ctx->tempCountdown != 0 )
+    {
+        return 0;
+    }
+
+    ctx->tempCountdown = ctx->tempPeriod;
+
+    calBits = _calibrationSelect( ctx->tempOffsetPpb + rtc3_tempCompDrift( ctx->tempCallback() ) );
+
+    // Bus traffic only when the best CAL bits actually change
+    if ( calBits == ( ctx->shadowConfig1 & 0x3F ) )
+    {
+        return 0;
+    }
+
+    rtc3_ctxSetCalibration( ctx, calBits >> 5, calBits & 0x1F );
+
+    return 1;
+}
+#endif
+
+/* Set trickle charge control function */
+void rtc3_ctxSetTrickleCharge( rtc3_t *ctx, uint8_t tch2 )
+{
+    uint8_t temp;
+
+    temp = ctx->shadowTrickleCharge2;
+
+    if ( tch2 == 0 )
+    {
+        temp &= ~_RTC3_TCH2_CLOSED;
+        temp |= _RTC3_TCH2_OPEN;
+    }
+
+    if ( tch2 == 1 )
+    {
+        temp |= _RTC3_TCH2_CLOSED;
+    }
+
+    rtc3_ctxWriteByte( ctx, _RTC3_REG_TRICKLE_CHARGE2, temp );
+}
+
+/* Set trickle charge bypass control function */
+void rtc3_ctxSetTrickleChargeBypass( rtc3_t *ctx, uint8_t tcfe )
+{
+    uint8_t temp;
+
+    temp = ctx->shadowConfig2;
+
+    if ( tcfe == 0 )
+    {
+        temp &= ~_RTC3_TCFE_CLOSED;
+        temp |= _RTC3_TCFE_OPEN;
+    }
+
+    if ( tcfe == 1 )
+    {
+        temp |= _RTC3_TCFE_CLOSED;
+    }
+
+    rtc3_ctxWriteByte( ctx, _RTC3_REG_CONFIG2, temp );
+}
+
+/* Set special function key byte 1 function */
+void rtc3_ctxSetSpecialFunctionKey1( rtc3_t *ctx, uint8_t sfkey1 )
+{
+    rtc3_ctxWriteByte( ctx, _RTC3_REG_SF_KEY1, sfkey1 );
+}
+
+/* Set special function key byte 2 function */
+void rtc3_ctxSetSpecialFunctionKey2( rtc3_t *ctx, uint8_t sfkey2 )
+{
+    rtc3_ctxWriteByte( ctx, _RTC3_REG_SF_KEY2, sfkey2 );
+}
+
+/* Set frequency calibration control function */
+void rtc3_ctxSetFrequencyCalibration( rtc3_t *ctx, uint8_t ftf )
+{
+    if ( ftf == 0 )
+    {
+        rtc3_ctxWriteByte( ctx, _RTC3_REG_SFR, _RTC3_FTF_NORMAL_512_HZ);
+    }
+
+    if ( ftf == 1 )
+    {
+        rtc3_ctxWriteByte( ctx, _RTC3_REG_SFR, _RTC3_FTF_1_HZ);
+    }
+}
+
+/* Set statistics clock function */
+void rtc3_setStatsClock( rtc3_counter_t clockFn )
+{
+#ifdef __HAL_STATS__
+    hal_statsMap( clockFn );
+#else
+    ( void )clockFn;
+#endif
+}
+
+/* Get statistics function */
+void rtc3_getStats( rtc3_stats_t *stats )
+{
+#ifdef __HAL_STATS__
+    stats->starts = hal_stats.starts;
+    stats->restarts = hal_stats.restarts;
+    stats->stops = hal_stats.stops;
+    stats->bytesWritten = hal_stats.bytesWritten;
+    stats->bytesRead = hal_stats.bytesRead;
+    stats->errors = hal_stats.errors;
+    stats->transactions = hal_stats.transactions;
+    stats->cycles = hal_stats.cycles;
+    stats->lastCycles = hal_stats.lastCycles;
+    stats->maxCycles = hal_stats.maxCycles;
+    stats->calls = hal_stats.calls;
+    stats->callCycles = hal_stats.callCycles;
+    stats->lastCallCycles = hal_stats.lastCallCycles;
+    stats->maxCallCycles = hal_stats.maxCallCycles;
+    stats->lastCallTransactions = hal_stats.lastCallTransactions;
+    stats->maxCallTransactions = hal_stats.maxCallTransactions;
+#else
+    stats->starts = 0;
+    stats->restarts = 0;
+    stats->stops = 0;
+    stats->bytesWritten = 0;
+    stats->bytesRead = 0;
+    stats->errors = 0;
+    stats->transactions = 0;
+    stats->cycles = 0;
+    stats->lastCycles = 0;
+    stats->maxCycles = 0;
+    stats->calls = 0;
+    stats->callCycles = 0;
+    stats->lastCallCycles = 0;
+    stats->maxCallCycles = 0;
+    stats->lastCallTransactions = 0;
+    stats->maxCallTransactions = 0;
+#endif
+}
+
+/* Reset statistics function */
+void rtc3_resetStats()
+{
+#ifdef __HAL_STATS__
+    hal_statsReset();
+#endif
+}
+
+/* Get state of interrupt pin function */
+uint8_t rtc3_ctxGetInterrupt( rtc3_t *ctx )
+{
+    _ctxSelect( ctx );
+
+    return hal_gpio_intGet();
+}
+
+/* Enable calibration output function */
+void rtc3_ctxEnableCalibrationOutput( rtc3_t *ctx, uint8_t ftf )
+{
+    hal_statsCallBegin();
+
+    rtc3_ctxSetSpecialFunctionKey1( ctx, _RTC3_SF_KEY1_VALUE );
+    rtc3_ctxSetSpecialFunctionKey2( ctx, _RTC3_SF_KEY2_VALUE );
+    rtc3_ctxSetFrequencyCalibration( ctx, ftf );
+
+    rtc3_ctxWriteByte( ctx, _RTC3_REG_CONFIG1, ctx->shadowConfig1 | _RTC3_CONFIG1_FT );
+
+    hal_statsCallEnd();
+}
+
+/* Disable calibration output function */
+void rtc3_ctxDisableCalibrationOutput( rtc3_t *ctx )
+{
+    rtc3_ctxWriteByte( ctx, _RTC3_REG_CONFIG1, ctx->shadowConfig1 & ~_RTC3_CONFIG1_FT );
+}
+
+#ifdef __RTC3_ENABLE_CLOCK__
+/* Start software clock function */
+uint8_t rtc3_ctxClockStart( rtc3_t *ctx, rtc3_counter_t counter, uint32_t counterHz, uint16_t resyncPeriod )
+{
+    uint32_t polls;
+    uint32_t stamp;
+    uint8_t  pinLast;
+    uint8_t  pinState;
+    uint8_t  error;
+
+    ctx->clockRunning = 0;
+    ctx->clockCounter = counter;
+    ctx->clockTicksPerMs = counterHz / 1000;
+    ctx->clockResyncPeriod = resyncPeriod;
+
+    hal_statsCallBegin();
+
+    rtc3_ctxEnableCalibrationOutput( ctx, _RTC3_FTF_1_HZ );
+
+    // Align to a seconds rollover, the 1 Hz output rises with it,
+    // two seconds without an edge means the output is not running
+    if ( counter != 0 )
+    {
+        error = _waitRisingEdge( ctx, counter, counterHz << 1, &stamp );
+        ctx->clockEdgeStamp = stamp;
+    }
+    else
+    {
+        error = 1;
+        pinLast = rtc3_ctxGetInterrupt( ctx );
+
+        for ( polls = 0; polls < _RTC3_CLOCK_START_POLLS; polls++ )
+        {
+            pinState = rtc3_ctxGetInterrupt( ctx );
+
+            if ( ( pinState != 0 ) && ( pinLast == 0 ) )
+            {
+                error = 0;
+                break;
+            }
+
+            pinLast = pinState;
+        }
+    }
+
+    if ( error != 0 )
+    {
+        hal_statsCallEnd();
+        return 1;
+    }
+
+    rtc3_ctxGetDateTime( ctx, &ctx->clockTime );
+    _clockPublish( ctx );
+
+    hal_statsCallEnd();
+
+    ctx->tickPinLast = 1;
+    ctx->clockEdges = 0;
+    ctx->clockSinceSync = 0;
+    ctx->clockSyncPending = 0;
+    ctx->clockResyncDue = 0;
+    ctx->clockRunning = 1;
+
+    return 0;
+}
+
+/* Stop software clock function */
+void rtc3_ctxClockStop( rtc3_t *ctx )
+{
+    ctx->clockRunning = 0;
+}
+
+/* Software clock edge function */
+void rtc3_ctxClockEdge( rtc3_t *ctx )
+{
+    rtc3_datetime_t time;
+
+    if ( ctx->clockRunning == 0 )
+    {
+        return;
+    }
+
+    ctx->clockSeq++;
+
+    if ( ctx->clockCounter != 0 )
+    {
+        ctx->clockEdgeStamp = ctx->clockCounter();
+    }
+
+    ctx->clockEdges++;
+
+    // The interrupt is the only writer, work on a copy and store it once
+    time = ctx->clockTime;
+
+    if ( ctx->clockSyncPending != 0 )
+    {
+        time = ctx->clockSyncTime;
+        ctx->clockSyncEdges++;
+
+        while ( ctx->clockSyncEdges != ctx->clockEdges )
+        {
+            _dateTimeIncrement( &time );
+            ctx->clockSyncEdges++;
+        }
+
+        ctx->clockSyncPending = 0;
+        ctx->clockSinceSync = 0;
+    }
+
+    _dateTimeIncrement( &time );
+    _clockCopy( &ctx->clockTime, &time );
+
+    if ( ( ctx->clockResyncPeriod != 0 ) && ( ++ctx->clockSinceSync >= ctx->clockResyncPeriod ) )
+    {
+        ctx->clockResyncDue = 1;
+    }
+
+    _clockPublish( ctx );
+
+    ctx->clockSeq++;
+}
+
+/* Software clock service function */
+void rtc3_ctxClockService( rtc3_t *ctx )
+{
+    if ( ( ctx->clockRunning != 0 ) && ( ctx->clockResyncDue != 0 ) && ( ctx->clockSyncPending == 0 ) )
+    {
+        ctx->clockResyncDue = 0;
+
+        hal_statsCallBegin();
+        _clockSync( ctx );
+        hal_statsCallEnd();
+    }
+}
+
+/* Software clock re-sync request function */
+void rtc3_ctxClockResync( rtc3_t *ctx )
+{
+    ctx->clockResyncDue = 1;
+}
+
+/* Get software clock time function */
+void rtc3_ctxClockGet( rtc3_t *ctx, rtc3_datetime_t *dateTime, uint16_t *milliseconds )
+{
+    uint8_t  seq;
+    uint32_t stamp;
+    uint32_t elapsed;
+
+    do
+    {
+        seq = ctx->clockSeq;
+        _clockCopy( dateTime, &ctx->clockTime );
+        stamp = ctx->clockEdgeStamp;
+    }
+    while ( ( seq & 0x01 ) || ( seq != ctx->clockSeq ) );
+
+    if ( milliseconds == 0 )
+    {
+        return;
+    }
+
+    *milliseconds = 0;
+
+    if ( ( ctx->clockCounter != 0 ) && ( ctx->clockTicksPerMs != 0 ) )
+    {
+        elapsed = ( ctx->clockCounter() - stamp ) / ctx->clockTicksPerMs;
+
+        *milliseconds = ( elapsed > 999 ) ? 999 : ( uint16_t )elapsed;
+    }
+}
+#endif
+
+#ifdef __RTC3_ENABLE_SUBSEC__
+/* Start sub-second clock function */
+uint8_t rtc3_ctxSubsecStart( rtc3_t *ctx, rtc3_counter_t edgeCounter, uint16_t resyncPeriod )
+{
+    uint8_t error;
+
+    ctx->subsecLocked = 0;
+    ctx->subsecCounter = edgeCounter;
+    ctx->subsecResyncPeriod = resyncPeriod;
+    ctx->subsecWindow = _RTC3_SUBSEC_WINDOW;
+
+    hal_statsCallBegin();
+
+    rtc3_ctxEnableCalibrationOutput( ctx, _RTC3_FTF_NORMAL_512_HZ );
+    error = _subsecLock( ctx, _RTC3_SUBSEC_LOCK_EDGES );
+
+    hal_statsCallEnd();
+
+    return error;
+}
+
+/* Stop sub-second clock function */
+void rtc3_ctxSubsecStop( rtc3_t *ctx )
+{
+    ctx->subsecLocked = 0;
+}
+
+/* Sub-second clock edge function */
+void rtc3_ctxSubsecEdge( rtc3_t *ctx )
+{
+    ctx->subsecEdges++;
+}
+
+/* Sub-second clock service function */
+uint8_t rtc3_ctxSubsecService( rtc3_t *ctx )
+{
+    uint16_t fraction;
+    uint32_t epoch;
+    uint8_t  error;
+
+    if ( ( ctx->subsecLocked == 0 ) || ( ctx->subsecResyncPeriod == 0 ) )
+    {
+        return 0;
+    }
+
+    epoch = rtc3_ctxSubsecGet( ctx, &fraction );
+
+    // Re-lock only just before the predicted rollover, the poll stays a few edges long
+    if ( ( epoch - ctx->subsecPubEpoch[ ctx->subsecPubIndex ] < ctx->subsecResyncPeriod ) ||
+         ( fraction < _RTC3_SUBSEC_HZ - ctx->subsecWindow ) )
+    {
+        return 0;
+    }
+
+    hal_statsCallBegin();
+    error = _subsecLock( ctx, ( ctx->subsecWindow << 1 ) + 1 );
+    hal_statsCallEnd();
+
+    if ( error == 0 )
+    {
+        ctx->subsecWindow = _RTC3_SUBSEC_WINDOW;
+        return 1;
+    }
+
+    // Missed, search a wider window around the next rollover
+    if ( ctx->subsecWindow < _RTC3_SUBSEC_HZ / 2 )
+    {
+        ctx->subsecWindow <<= 1;
+    }
+
+    return 0;
+}
+
+/* Get sub-second clock time function */
+uint32_t rtc3_ctxSubsecGet( rtc3_t *ctx, uint16_t *fraction )
+{
+    uint8_t  pub;
+    uint32_t elapsed;
+    int32_t  slip;
+
+    if ( fraction != 0 )
+    {
+        *fraction = 0;
+    }
+
+    if ( ctx->subsecLocked == 0 )
+    {
+        return 0;
+    }
+
+    pub = ctx->subsecPubIndex;
+    elapsed = _subsecCount( ctx ) - ctx->subsecPubEdge[ pub ];
+    slip = ctx->subsecPubSlip[ pub ];
+
+    if ( slip != 0 )
+    {
+        elapsed -= ( uint32_t )( ( int32_t )elapsed / slip );
+    }
+
+    if ( fraction != 0 )
+    {
+        *fraction = ( uint16_t )( elapsed & _RTC3_SUBSEC_MASK );
+    }
+
+    return ctx->subsecPubEpoch[ pub ] + ( elapsed >> _RTC3_SUBSEC_SHIFT );
+}
+#endif
+
+/* Tick service init function */
+void rtc3_ctxTickInit( rtc3_t *ctx, rtc3_tick_t callback )
+{
+    ctx->tickCallback = callback;
+    ctx->tickPending = 0;
+
+    rtc3_ctxEnableCalibrationOutput( ctx, _RTC3_FTF_1_HZ );
+
+    ctx->tickPinLast = rtc3_ctxGetInterrupt( ctx );
+}
+
+/* Tick interrupt function */
+void rtc3_ctxTickIsr( rtc3_t *ctx )
+{
+#ifdef __RTC3_ENABLE_CLOCK__
+    rtc3_ctxClockEdge( ctx );
+#endif
+
+    ctx->tickPending = 1;
+
+    if ( ctx->tickCallback != 0 )
+    {
+        ctx->tickCallback();
+    }
+}
+
+/* Tick service function */
+uint8_t rtc3_ctxTickService( rtc3_t *ctx )
+{
+    uint8_t pinState;
+    uint8_t edge;
+
+    pinState = rtc3_ctxGetInterrupt( ctx );
+    edge = ( pinState != 0 ) && ( ctx->tickPinLast == 0 );
+    ctx->tickPinLast = pinState;
+
+    if ( edge )
+    {
+        rtc3_ctxTickIsr( ctx );
+    }
+
+#ifdef __RTC3_ENABLE_CLOCK__
+    rtc3_ctxClockService( ctx );
+#endif
+
+    return edge;
+}
+
+/* Tick pending function */
+uint8_t rtc3_ctxTickPending( rtc3_t *ctx )
+{
+    if ( ctx->tickPending == 0 )
+    {
+        return 0;
+    }
+
+    ctx->tickPending = 0;
+
+    return 1;
+}
+
+#ifdef __RTC3_ENABLE_ASYNC__
+/* Asynchronous burst read function */
+uint8_t rtc3_ctxReadBlockAsync( rtc3_t *ctx, uint8_t startReg, uint8_t *pBuf, uint8_t nBytes, rtc3_done_t done )
+{
+    if ( ctx->asyncState != _RTC3_ASYNC_IDLE )
+    {
+        return 1;
+    }
+
+    ctx->asyncDest = pBuf;
+    ctx->asyncDateTime = 0;
+
+    return _asyncBegin( ctx, 1, startReg, nBytes, done );
+}
+
+/* Asynchronous burst write function */
+uint8_t rtc3_ctxWriteBlockAsync( rtc3_t *ctx, uint8_t startReg, uint8_t *pBuf, uint8_t nBytes, rtc3_done_t done )
+{
+    uint8_t cnt;
+
+    if ( ctx->asyncState != _RTC3_ASYNC_IDLE )
+    {
+        return 1;
+    }
+
+    if ( nBytes > _RTC3_BLOCK_SIZE_MAX )
+    {
+        nBytes = _RTC3_BLOCK_SIZE_MAX;
+    }
+
+    for ( cnt = 0; cnt < nBytes; cnt++ )
+    {
+        ctx->asyncFrame[ 1 + cnt ] = pBuf[ cnt ];
+    }
+
+    ctx->asyncDateTime = 0;
+
+    return _asyncBegin( ctx, 0, startReg, nBytes, done );
+}
+
+/* Asynchronous get date and time function */
+uint8_t rtc3_ctxGetDateTimeAsync( rtc3_t *ctx, rtc3_datetime_t *dateTime, rtc3_done_t done )
+{
+    if ( ctx->asyncState != _RTC3_ASYNC_IDLE )
+    {
+        return 1;
+    }
+
+    ctx->asyncDateTime = dateTime;
+
+    return _asyncBegin( ctx, 1, _RTC3_REG_TIME_SEC, 7, done );
+}
+
+/* Asynchronous set date and time function */
+uint8_t rtc3_ctxSetDateTimeAsync( rtc3_t *ctx, rtc3_datetime_t *dateTime, rtc3_done_t done )
+{
+    if ( ctx->asyncState != _RTC3_ASYNC_IDLE )
+    {
+        return 1;
+    }
+
+    _dateTimeEncode( dateTime, &ctx->asyncFrame[ 1 ] );
+    ctx->asyncDateTime = 0;
+
+    return _asyncBegin( ctx, 0, _RTC3_REG_TIME_SEC, 7, done );
+}
+
+/* Asynchronous transfer poll function */
+void rtc3_ctxPoll( rtc3_t *ctx )
+{
+#ifdef __HAL_I2C_DMA__
+    if ( ( ctx->asyncState == _RTC3_ASYNC_DMA ) && hal_i2cDmaDone() )
+    {
+        ctx->asyncError = hal_i2cDmaError();
+        ctx->asyncState = _RTC3_ASYNC_COMPLETE;
+    }
+#endif
+#ifdef __HAL_I2C_ASYNC__
+    while ( ( ctx->asyncState != _RTC3_ASYNC_IDLE ) && ( ctx->asyncState != _RTC3_ASYNC_COMPLETE ) && hal_i2cAsyncDone() )
+    {
+        _asyncStep( ctx );
+    }
+#endif
+
+    if ( ctx->asyncState == _RTC3_ASYNC_COMPLETE )
+    {
+        _asyncFinish( ctx );
+    }
+}
+
+/* Asynchronous transfer busy function */
+uint8_t rtc3_ctxAsyncBusy( rtc3_t *ctx )
+{
+    return ctx->asyncState != _RTC3_ASYNC_IDLE;
+}
+#endif
+
+#ifdef __RTC3_ENABLE_EVENTS__
+/* Event push function */
+uint8_t rtc3_ctxEventPush( rtc3_t *ctx, uint8_t source )
+{
+    uint8_t  head;
+    uint8_t  count;
+    uint8_t  pub;
+    uint32_t ticks;
+
+    head = ctx->eventHead;
+    count = head - ctx->eventTail;
+
+    if ( count >= __RTC3_EVENT_RING_SIZE__ )
+    {
+        ctx->eventOverflows++;
+        return 1;
+    }
+
+    // Cached time only, the ms division is left to the consumer
+    pub = ctx->clockPubIndex;
+    ticks = 0;
+
+    if ( ( ctx->clockRunning != 0 ) && ( ctx->clockCounter != 0 ) )
+    {
+        ticks = ctx->clockCounter() - ctx->clockPubStamp[ pub ];
+    }
+
+    ctx->eventEpoch[ head & _RTC3_EVENT_RING_MASK ] = ( ctx->clockRunning != 0 ) ? ctx->clockPubEpoch[ pub ] : 0;
+    ctx->eventTicks[ head & _RTC3_EVENT_RING_MASK ] = ticks;
+    ctx->eventSource[ head & _RTC3_EVENT_RING_MASK ] = source;
+
+    // Publish the entry only after it is complete
+    ctx->eventHead = head + 1;
+
+    if ( ++count > ctx->eventHighWater )
+    {
+        ctx->eventHighWater = count;
+    }
+
+    return 0;
+}
+
+/* Event pop function */
+uint8_t rtc3_ctxEventPop( rtc3_t *ctx, rtc3_event_t *event )
+{
+    uint8_t  tail;
+    uint32_t ms;
+
+    tail = ctx->eventTail;
+
+    if ( tail == ctx->eventHead )
+    {
+        return 0;
+    }
+
+    event->epoch = ctx->eventEpoch[ tail & _RTC3_EVENT_RING_MASK ];
+    event->source = ctx->eventSource[ tail & _RTC3_EVENT_RING_MASK ];
+    ms = 0;
+
+    if ( ctx->clockTicksPerMs != 0 )
+    {
+        ms = ctx->eventTicks[ tail & _RTC3_EVENT_RING_MASK ] / ctx->clockTicksPerMs;
+    }
+
+    event->milliseconds = ( ms > 999 ) ? 999 : ( uint16_t )ms;
+
+    // Release the slot only after it has been copied out
+    ctx->eventTail = tail + 1;
+
+    return 1;
+}
+
+/* Event count function */
+uint8_t rtc3_ctxEventCount( rtc3_t *ctx )
+{
+    return ( uint8_t )( ctx->eventHead - ctx->eventTail );
+}
+
+/* Event overflow count function */
+uint16_t rtc3_ctxEventOverflows( rtc3_t *ctx )
+{
+    uint16_t overflows;
+
+    // Re-read until stable, the producer may update it between the two bytes
+    do
+    {
+        overflows = ctx->eventOverflows;
+    }
+    while ( overflows != ctx->eventOverflows );
+
+    return overflows;
+}
+
+/* Event high water mark function */
+uint8_t rtc3_ctxEventHighWater( rtc3_t *ctx )
+{
+    return ctx->eventHighWater;
+}
+#endif
+
+/* --------------------------------------------------------- DEFAULT INSTANCE */
+
+/* Generic read byte of data function */
+uint8_t rtc3_readByte( uint8_t regAddress )
+{
+    return rtc3_ctxReadByte( &_rtc3Default, regAddress );
+}
+
+/* Generic write byte of data function */
+void rtc3_writeByte( uint8_t regAddress, uint8_t writeData )
+{
+    rtc3_ctxWriteByte( &_rtc3Default, regAddress, writeData );
+}
+
+/* Generic burst read function */
+uint8_t rtc3_readBlock( uint8_t startReg, uint8_t *pBuf, uint8_t nBytes )
+{
+    return rtc3_ctxReadBlock( &_rtc3Default, startReg, pBuf, nBytes );
+}
+
+/* Generic burst write function */
+uint8_t rtc3_writeBlock( uint8_t startReg, uint8_t *pBuf, uint8_t nBytes )
+{
+    return rtc3_ctxWriteBlock( &_rtc3Default, startReg, pBuf, nBytes );
+}
+
+/* Synchronize configuration shadow registers function */
+void rtc3_syncShadow()
+{
+    rtc3_ctxSyncShadow( &_rtc3Default );
+}
+
+/* Enable counting function */
+void rtc3_enableCounting()
+{
+    rtc3_ctxEnableCounting( &_rtc3Default );
+}
+
+/* Disable counting function */
+void rtc3_disableCounting()
+{
+    rtc3_ctxDisableCounting( &_rtc3Default );
+}
+
+/* Get seconds function */
+uint8_t rtc3_getTimeSeconds()
+{
+    return rtc3_ctxGetTimeSeconds( &_rtc3Default );
+}
+
+/* Set seconds function */
+void rtc3_setTimeSeconds( uint8_t seconds )
+{
+    rtc3_ctxSetTimeSeconds( &_rtc3Default, seconds );
+}
+
+/* Get minutes function */
+uint8_t rtc3_getTimeMinutes()
+{
+    return rtc3_ctxGetTimeMinutes( &_rtc3Default );
+}
+
+/* Set minutes function */
+void rtc3_setTimeMinutes( uint8_t minutes )
+{
+    rtc3_ctxSetTimeMinutes( &_rtc3Default, minutes );
+}
+
+/* Get hours function */
+uint8_t rtc3_getTimeHours()
+{
+    return rtc3_ctxGetTimeHours( &_rtc3Default );
+}
+
+/* Set hours function */
+void rtc3_setTimeHours( uint8_t hours )
+{
+    rtc3_ctxSetTimeHours( &_rtc3Default, hours );
+}
+
+/* Get day of the week function */
+uint8_t rtc3_getDayOfTheWeek()
+{
+    return rtc3_ctxGetDayOfTheWeek( &_rtc3Default );
+}
+
+/* Set day of the week function */
+void rtc3_setDayOfTheWeek( uint8_t wDay )
+{
+    rtc3_ctxSetDayOfTheWeek( &_rtc3Default, wDay );
+}
+
+/* Get day function */
+uint8_t rtc3_getDateDay()
+{
+    return rtc3_ctxGetDateDay( &_rtc3Default );
+}
+
+/* Set day function */
+void rtc3_setDateDay( uint8_t dateDay )
+{
+    rtc3_ctxSetDateDay( &_rtc3Default, dateDay );
+}
+
+/* Get month function */
+uint8_t rtc3_getDateMonth()
+{
+    return rtc3_ctxGetDateMonth( &_rtc3Default );
+}
+
+/* Set month function */
+void rtc3_setDateMonth( uint8_t dateMonth )
+{
+    rtc3_ctxSetDateMonth( &_rtc3Default, dateMonth );
+}
+
+/* Get year function */
+uint8_t rtc3_getDateYear()
+{
+    return rtc3_ctxGetDateYear( &_rtc3Default );
+}
+
+/* Set year function */
+void rtc3_setDateYear( uint16_t dateYear )
+{
+    rtc3_ctxSetDateYear( &_rtc3Default, dateYear );
+}
+
+/* Set time hours, minutes and seconds function */
+void rtc3_setTime( uint8_t timeHours, uint8_t timeMinutes, uint8_t timeSeconds )
+{
+    rtc3_ctxSetTime( &_rtc3Default, timeHours, timeMinutes, timeSeconds );
+}
+
+/* Get time hours, minutes and seconds function */
+void rtc3_getTime( uint8_t *timeHours, uint8_t *timeMinutes, uint8_t *timeSeconds )
+{
+    rtc3_ctxGetTime( &_rtc3Default, timeHours, timeMinutes, timeSeconds );
+}
+
+/* Set date hours, minutes and seconds function */
+void rtc3_setDate( uint8_t dayOfTheWeek, uint8_t dateDay, uint8_t dateMonth, uint16_t dateYear )
+{
+    rtc3_ctxSetDate( &_rtc3Default, dayOfTheWeek, dateDay, dateMonth, dateYear );
+}
+
+/* Get time hours, minutes and seconds function */
+void rtc3_getDate( uint8_t *dayOfTheWeek, uint8_t *dateDay, uint8_t *dateMonth, uint16_t *dateYear )
+{
+    rtc3_ctxGetDate( &_rtc3Default, dayOfTheWeek, dateDay, dateMonth, dateYear );
+}
+
+/* Set date and time function */
+void rtc3_setDateTime( rtc3_datetime_t *dateTime )
+{
+    rtc3_ctxSetDateTime( &_rtc3Default, dateTime );
+}
+
+/* Set date and time on a reference second function */
+uint8_t rtc3_setDateTimeAligned( rtc3_datetime_t *dateTime, rtc3_counter_t counter, uint32_t counterHz, uint32_t refStamp, uint32_t *latency )
+{
+    return rtc3_ctxSetDateTimeAligned( &_rtc3Default, dateTime, counter, counterHz, refStamp, latency );
+}
+
+/* Get date and time function */
+void rtc3_getDateTime( rtc3_datetime_t *dateTime )
+{
+    rtc3_ctxGetDateTime( &_rtc3Default, dateTime );
+}
+
+/* Poll date and time for a change function */
+uint8_t rtc3_pollChanged( rtc3_datetime_t *dateTime )
+{
+    return rtc3_ctxPollChanged( &_rtc3Default, dateTime );
+}
+
+/* Get epoch function */
+uint32_t rtc3_getEpoch()
+{
+    return rtc3_ctxGetEpoch( &_rtc3Default );
+}
+
+/* Set epoch function */
+void rtc3_setEpoch( uint32_t epoch )
+{
+    rtc3_ctxSetEpoch( &_rtc3Default, epoch );
+}
+
+/* Get raw date and time snapshot function */
+void rtc3_getSnapshot( rtc3_snapshot_t *snapshot )
+{
+    rtc3_ctxGetSnapshot( &_rtc3Default, snapshot );
+}
+
+/* Set calibration function */
+void rtc3_setCalibration( uint8_t calSign, uint8_t calNumber )
+{
+    rtc3_ctxSetCalibration( &_rtc3Default, calSign, calNumber );
+}
+
+/* Automatic calibration function */
+uint8_t rtc3_autoCalibrate( rtc3_counter_t counter, uint32_t counterHz, uint8_t ftf, uint16_t periods, rtc3_calibration_t *result )
+{
+    return rtc3_ctxAutoCalibrate( &_rtc3Default, counter, counterHz, ftf, periods, result );
+}
+
+#ifdef __RTC3_ENABLE_TEMPCOMP__
+/* Temperature compensation init function */
+void rtc3_tempCompInit( rtc3_temperature_t temperature, int32_t offsetPpb, uint16_t period )
+{
+    rtc3_ctxTempCompInit( &_rtc3Default, temperature, offsetPpb, period );
+}
+
+/* Temperature compensation service function */
+uint8_t rtc3_tempCompService()
+{
+    return rtc3_ctxTempCompService( &_rtc3Default );
+}
+#endif
+
+/* Set trickle charge control function */
+void rtc3_setTrickleCharge( uint8_t tch2 )
+{
+    rtc3_ctxSetTrickleCharge( &_rtc3Default, tch2 );
+}
+
+/* Set trickle charge bypass control function */
+void rtc3_setTrickleChargeBypass( uint8_t tcfe )
+{
+    rtc3_ctxSetTrickleChargeBypass( &_rtc3Default, tcfe );
+}
+
+/* Set special function key byte 1 function */
+void rtc3_setSpecialFunctionKey1( uint8_t sfkey1 )
+{
+    rtc3_ctxSetSpecialFunctionKey1( &_rtc3Default, sfkey1 );
+}
+
+/* Set special function key byte 2 function */
+void rtc3_setSpecialFunctionKey2( uint8_t sfkey2 )
+{
+    rtc3_ctxSetSpecialFunctionKey2( &_rtc3Default, sfkey2 );
+}
+
+/* Set frequency calibration control function */
+void rtc3_setFrequencyCalibration( uint8_t ftf )
+{
+    rtc3_ctxSetFrequencyCalibration( &_rtc3Default, ftf );
+}
+
+/* Get state of interrupt pin function */
+uint8_t rtc3_getInterrupt()
+{
+    return rtc3_ctxGetInterrupt( &_rtc3Default );
+}
+
+/* Enable calibration output function */
+void rtc3_enableCalibrationOutput( uint8_t ftf )
+{
+    rtc3_ctxEnableCalibrationOutput( &_rtc3Default, ftf );
+}
+
+/* Disable calibration output function */
+void rtc3_disableCalibrationOutput()
+{
+    rtc3_ctxDisableCalibrationOutput( &_rtc3Default );
+}
+
+#ifdef __RTC3_ENABLE_CLOCK__
+/* Start software clock function */
+uint8_t rtc3_clockStart( rtc3_counter_t counter, uint32_t counterHz, uint16_t resyncPeriod )
+{
+    return rtc3_ctxClockStart( &_rtc3Default, counter, counterHz, resyncPeriod );
+}
+
+/* Stop software clock function */
+void rtc3_clockStop()
+{
+    rtc3_ctxClockStop( &_rtc3Default );
+}
+
+/* Software clock edge function */
+void rtc3_clockEdge()
+{
+    rtc3_ctxClockEdge( &_rtc3Default );
+}
+
+/* Software clock service function */
+void rtc3_clockService()
+{
+    rtc3_ctxClockService( &_rtc3Default );
+}
+
+/* Software clock re-sync request function */
+void rtc3_clockResync()
+{
+    rtc3_ctxClockResync( &_rtc3Default );
+}
+
+/* Get software clock time function */
+void rtc3_clockGet( rtc3_datetime_t *dateTime, uint16_t *milliseconds )
+{
+    rtc3_ctxClockGet( &_rtc3Default, dateTime, milliseconds );
+}
+#endif
+
+#ifdef __RTC3_ENABLE_SUBSEC__
+/* Start sub-second clock function */
+uint8_t rtc3_subsecStart( rtc3_counter_t edgeCounter, uint16_t resyncPeriod )
+{
+    return rtc3_ctxSubsecStart( &_rtc3Default, edgeCounter, resyncPeriod );
+}
+
+/* Stop sub-second clock function */
+void rtc3_subsecStop()
+{
+    rtc3_ctxSubsecStop( &_rtc3Default );
+}
+
+/* Sub-second clock edge function */
+void rtc3_subsecEdge()
+{
+    rtc3_ctxSubsecEdge( &_rtc3Default );
+}
+
+/* Sub-second clock service function */
+uint8_t rtc3_subsecService()
+{
+    return rtc3_ctxSubsecService( &_rtc3Default );
+}
+
+/* Get sub-second clock time function */
+uint32_t rtc3_subsecGet( uint16_t *fraction )
+{
+    return rtc3_ctxSubsecGet( &_rtc3Default, fraction );
+}
+#endif
+
+/* Tick service init function */
+void rtc3_tickInit( rtc3_tick_t callback )
+{
+    rtc3_ctxTickInit( &_rtc3Default, callback );
+}
+
+/* Tick interrupt function */
+void rtc3_tickIsr()
+{
+    rtc3_ctxTickIsr( &_rtc3Default );
+}
+
+/* Tick service function */
+uint8_t rtc3_tickService()
+{
+    return rtc3_ctxTickService( &_rtc3Default );
+}
+
+/* Tick pending function */
+uint8_t rtc3_tickPending()
+{
+    return rtc3_ctxTickPending( &_rtc3Default );
+}
+
+#ifdef __RTC3_ENABLE_ASYNC__
+/* Asynchronous burst read function */
+uint8_t rtc3_readBlockAsync( uint8_t startReg, uint8_t *pBuf, uint8_t nBytes, rtc3_done_t done )
+{
+    return rtc3_ctxReadBlockAsync( &_rtc3Default, startReg, pBuf, nBytes, done );
+}
+
+/* Asynchronous burst write function */
+uint8_t rtc3_writeBlockAsync( uint8_t startReg, uint8_t *pBuf, uint8_t nBytes, rtc3_done_t done )
+{
+    return rtc3_ctxWriteBlockAsync( &_rtc3Default, startReg, pBuf, nBytes, done );
+}
+
+/* Asynchronous get date and time function */
+uint8_t rtc3_getDateTimeAsync( rtc3_datetime_t *dateTime, rtc3_done_t done )
+{
+    return rtc3_ctxGetDateTimeAsync( &_rtc3Default, dateTime, done );
+}
+
+/* Asynchronous set date and time function */
+uint8_t rtc3_setDateTimeAsync( rtc3_datetime_t *dateTime, rtc3_done_t done )
+{
+    return rtc3_ctxSetDateTimeAsync( &_rtc3Default, dateTime, done );
+}
+
+/* Asynchronous transfer poll function */
+void rtc3_poll()
+{
+    rtc3_ctxPoll( &_rtc3Default );
+}
+
+/* Asynchronous transfer busy function */
+uint8_t rtc3_asyncBusy()
+{
+    return rtc3_ctxAsyncBusy( &_rtc3Default );
+}
+#endif
+
+#ifdef __RTC3_ENABLE_EVENTS__
+/* Event push function */
+uint8_t rtc3_eventPush( uint8_t source )
+{
+    return rtc3_ctxEventPush( &_rtc3Default, source );
+}
+
+/* Event pop function */
+uint8_t rtc3_eventPop( rtc3_event_t *event )
+{
+    return rtc3_ctxEventPop( &_rtc3Default, event );
+}
+
+/* Event count function */
+uint8_t rtc3_eventCount()
+{
+    return rtc3_ctxEventCount( &_rtc3Default );
+}
+
+/* Event overflow count function */
+uint16_t rtc3_eventOverflows()
+{
+    return rtc3_ctxEventOverflows( &_rtc3Default );
+}
+
+/* Event high water mark function */
+uint8_t rtc3_eventHighWater()
+{
+    return rtc3_ctxEventHighWater( &_rtc3Default );
+}
+#endif
+
 
 
 /* -------------------------------------------------------------------------- */
@@ -51,6 +51,26 @@
    #define   __RTC3_DRV_I2C__                            /**<     @macro __RTC3_DRV_I2C__  @brief I2C driver selector */                                          
 // #define   __RTC3_DRV_UART__                           /**<     @macro __RTC3_DRV_UART__ @brief UART driver selector */ 
 
+// #define   __RTC3_ENABLE_CLOCK__                       /**<     @macro __RTC3_ENABLE_CLOCK__ @brief Software clock, rtc3_clock* */
+// #define   __RTC3_ENABLE_SUBSEC__                      /**<     @macro __RTC3_ENABLE_SUBSEC__ @brief Sub-second clock, rtc3_subsec* */
+// #define   __RTC3_ENABLE_ASYNC__                       /**<     @macro __RTC3_ENABLE_ASYNC__ @brief Asynchronous transfers, rtc3_*Async and rtc3_poll, needed by __HAL_I2C_ASYNC__ and __HAL_I2C_DMA__ */
+// #define   __RTC3_ENABLE_EVENTS__                      /**<     @macro __RTC3_ENABLE_EVENTS__ @brief Event timestamp ring, rtc3_event*, implies __RTC3_ENABLE_CLOCK__ */
+// #define   __RTC3_ENABLE_TEMPCOMP__                    /**<     @macro __RTC3_ENABLE_TEMPCOMP__ @brief Temperature compensation, rtc3_tempComp* */
+
+#if defined( __RTC3_ENABLE_EVENTS__ ) && !defined( __RTC3_ENABLE_CLOCK__ )
+   #define   __RTC3_ENABLE_CLOCK__
+#endif
+
+#ifndef __RTC3_EVENT_RING_SIZE__
+   #define   __RTC3_EVENT_RING_SIZE__  16                /**<     @macro __RTC3_EVENT_RING_SIZE__ @brief Event ring entries, power of two [ 2 - 128 ] */
+#endif
+#ifndef __RTC3_TC_TURNOVER__
+   #define   __RTC3_TC_TURNOVER__      25                /**<     @macro __RTC3_TC_TURNOVER__ @brief Crystal turnover temperature, degrees C */
+#endif
+#ifndef __RTC3_TC_COEFF_PPB__
+   #define   __RTC3_TC_COEFF_PPB__     34                /**<     @macro __RTC3_TC_COEFF_PPB__ @brief Crystal parabolic coefficient, ppb per degree C squared */
+#endif
+
                                                                        /** @} */
 /** @defgroup RTC3_VAR Variables */                           /** @{ */
 
@@ -70,11 +90,232 @@ extern const uint8_t _RTC3_REG_SF_KEY2;
 extern const uint8_t _RTC3_REG_SFR;
 extern const uint8_t _RTC3_ENABLE_COUNTING;
 extern const uint8_t _RTC3_DISABLE_COUNTING;
+extern const uint32_t _RTC3_EPOCH_MIN;
+extern const uint32_t _RTC3_EPOCH_MAX;
 
                                                                        /** @} */
 /** @defgroup RTC3_TYPES Types */                             /** @{ */
 
+/**
+ * @brief Date and time snapshot
+ *
+ * Fields are laid out in BQ32000 register order ( 0x00 - 0x06 ).
+ */
+typedef struct
+{
+    uint8_t  timeSeconds;                   /**< Time seconds [ 0 sec - 59 sec ] */
+    uint8_t  timeMinutes;                   /**< Time minutes [ 0 min - 59 min ] */
+    uint8_t  timeHours;                     /**< Time hours [ 0 h - 23 h ] */
+    uint8_t  dayOfTheWeek;                  /**< Day of the week [ 1 - 7 ] */
+    uint8_t  dateDay;                       /**< Date day [ 1 - 31 ] */
+    uint8_t  dateMonth;                     /**< Date month [ 1 - 12 ] */
+    uint16_t dateYear;                      /**< Date year [ 0 - 99 ] */
+
+}rtc3_datetime_t;
+
+/**
+ * @brief Raw date and time snapshot
+ *
+ * BCD registers 0x00 - 0x06 exactly as read in one transaction.
+ */
+typedef struct
+{
+    uint8_t  reg[ 7 ];
+
+}rtc3_snapshot_t;
+
+/**
+ * @brief Captured event timestamp
+ */
+typedef struct
+{
+    uint32_t epoch;                         /**< Unix time of the event */
+    uint16_t milliseconds;                  /**< Milliseconds into that second [ 0 - 999 ] */
+    uint8_t  source;                        /**< Event source given to rtc3_eventPush */
+
+}rtc3_event_t;
+
+/**
+ * @brief Automatic calibration result
+ */
+typedef struct
+{
+    int32_t  errorPpb;                      /**< Crystal error without calibration, ppb, positive runs fast */
+    int32_t  residualPpb;                   /**< Error left with the programmed CAL bits, ppb */
+    uint32_t measuredTicks;                 /**< Counter ticks over the measurement window */
+    uint8_t  calSign;                       /**< Programmed calibration sign */
+    uint8_t  calNumber;                     /**< Programmed calibration number */
+
+}rtc3_calibration_t;
+
+/**
+ * @brief Free running counter function
+ *
+ * Returns a monotonically increasing ( wrapping ) MCU counter value,
+ * for example a timer or a core cycle counter.
+ */
+typedef uint32_t (*rtc3_counter_t)();
+
+/**
+ * @brief 1 Hz tick callback function
+ */
+typedef void (*rtc3_tick_t)();
+
+/**
+ * @brief Asynchronous transfer done callback function
+ *
+ * @param[in] error                0 - transfer completed, 1 - NACK from the chip
+ */
+typedef void (*rtc3_done_t)( uint8_t error );
+
+/**
+ * @brief Temperature reading function
+ *
+ * Returns the temperature next to the crystal in 0.1 degrees C.
+ */
+typedef int16_t (*rtc3_temperature_t)();
+
+#ifdef __HAL_LINUX__
+/**
+ * @brief Linux i2c-dev bus object
+ *
+ * Passed as the I2C object to rtc3_i2cDriverInit with __HAL_LINUX__.
+ * ioctlFn 0 calls ioctl(2) on fd, any other function with the same
+ * signature replaces the kernel, e.g. rtc3sim_i2cdevIoctl.
+ */
+typedef struct
+{
+    int      fd;                            /**< Open /dev/i2c-N adapter */
+    int      (*ioctlFn)( int fd, unsigned long request, void *arg );
+
+}rtc3_linuxI2c_t;
+#endif
+
+/**
+ * @brief I2C bus statistics
+ *
+ * Filled only when the HAL is built with __HAL_STATS__,
+ * otherwise all fields read as 0.
+ */
+typedef struct
+{
+    uint32_t starts;                        /**< START conditions */
+    uint32_t restarts;                      /**< Repeated START conditions */
+    uint32_t stops;                         /**< STOP conditions */
+    uint32_t bytesWritten;                  /**< Bytes driven by the master, address bytes included */
+    uint32_t bytesRead;                     /**< Bytes driven by the slave */
+    uint32_t errors;                        /**< NACK / error returns from the HAL */
+    uint32_t transactions;                  /**< Completed START ... STOP transactions */
+    uint32_t cycles;                        /**< Counter ticks spent in all transactions */
+    uint32_t lastCycles;                    /**< Counter ticks spent in the last transaction */
+    uint32_t maxCycles;                     /**< Longest transaction in counter ticks */
+    uint32_t calls;                         /**< Driver calls that reached the bus */
+    uint32_t callCycles;                    /**< Counter ticks spent in all those calls */
+    uint32_t lastCallCycles;                /**< Counter ticks spent in the last call */
+    uint32_t maxCallCycles;                 /**< Longest call in counter ticks */
+    uint32_t lastCallTransactions;          /**< Transactions made by the last call */
+    uint32_t maxCallTransactions;           /**< Most transactions made by one call */
+
+}rtc3_stats_t;
+
+/**
+ * @brief Driver instance
+ *
+ * Owns the bus and GPIO objects, the slave address and all state of one
+ * RTC 3 Click, so several boards can be driven from one firmware image.
+ * Fields are private to the driver, initialize with rtc3_ctxI2cDriverInit.
+ * State of the optional features is only present when their
+ * __RTC3_ENABLE_xxx__ selector is defined.
+ */
+typedef struct
+{
+    T_RTC3_P                 gpioObj;
+    T_RTC3_P                 i2cObj;
+    uint8_t                  slaveAddress;
+
+    // Shadow copies of the configuration registers
+    uint8_t                  shadowConfig1;
+    uint8_t                  shadowTrickleCharge2;
+    uint8_t                  shadowConfig2;
+    uint8_t                  shadowSfr;
+
+    // Delta polling, time registers as last seen
+    rtc3_snapshot_t          pollSnapshot;
+    uint8_t                  pollValid;
+
+#ifdef __RTC3_ENABLE_CLOCK__
+    // Software clock
+    rtc3_datetime_t          clockTime;
+    rtc3_datetime_t          clockSyncTime;
+    rtc3_counter_t           clockCounter;
+    uint32_t                 clockTicksPerMs;
+    uint16_t                 clockResyncPeriod;
+    volatile uint8_t         clockRunning;
+    volatile uint8_t         clockSeq;
+    volatile uint8_t         clockEdges;
+    volatile uint8_t         clockSyncEdges;
+    volatile uint8_t         clockSyncPending;
+    volatile uint8_t         clockResyncDue;
+    volatile uint16_t        clockSinceSync;
+    volatile uint32_t        clockEdgeStamp;
+    volatile uint32_t        clockPubEpoch[ 2 ];
+    volatile uint32_t        clockPubStamp[ 2 ];
+    volatile uint8_t         clockPubIndex;
+#endif
+
+#ifdef __RTC3_ENABLE_SUBSEC__
+    // Sub-second clock, 512 Hz edges locked to the seconds rollover
+    rtc3_counter_t           subsecCounter;
+    volatile uint32_t        subsecEdges;
+    uint16_t                 subsecResyncPeriod;
+    uint16_t                 subsecWindow;
+    uint32_t                 subsecRefEdge;
+    uint32_t                 subsecRefEpoch;
+    volatile uint8_t         subsecLocked;
+    volatile uint32_t        subsecPubEpoch[ 2 ];
+    volatile uint32_t        subsecPubEdge[ 2 ];
+    volatile int32_t         subsecPubSlip[ 2 ];
+    volatile uint8_t         subsecPubIndex;
+#endif
+
+    // 1 Hz tick service
+    rtc3_tick_t              tickCallback;
+    uint8_t                  tickPinLast;
+    volatile uint8_t         tickPending;
+
+#ifdef __RTC3_ENABLE_ASYNC__
+    // Asynchronous transfer engine
+    volatile uint8_t         asyncState;
+    uint8_t                  asyncRead;
+    uint8_t                  asyncCount;
+    uint8_t                  asyncIndex;
+    uint8_t                  asyncError;
+    uint8_t                  asyncFrame[ 11 ];    // Register pointer, then data
+    uint8_t                  *asyncDest;
+    rtc3_datetime_t          *asyncDateTime;
+    rtc3_done_t              asyncDone;
+#endif
 
+#ifdef __RTC3_ENABLE_EVENTS__
+    // Event timestamp ring, single producer / single consumer
+    volatile uint32_t        eventEpoch[ __RTC3_EVENT_RING_SIZE__ ];
+    volatile uint32_t        eventTicks[ __RTC3_EVENT_RING_SIZE__ ];
+    volatile uint8_t         eventSource[ __RTC3_EVENT_RING_SIZE__ ];
+    volatile uint8_t         eventHead;
+    volatile uint8_t         eventTail;
+    volatile uint8_t         eventHighWater;
+    volatile uint16_t        eventOverflows;
+#endif
+
+#ifdef __RTC3_ENABLE_TEMPCOMP__
+    // Temperature compensation
+    rtc3_temperature_t       tempCallback;
+    int32_t                  tempOffsetPpb;
+    uint16_t                 tempPeriod;
+    uint16_t                 tempCountdown;
+#endif
+
+}rtc3_t;
 
                                                                        /** @} */
 #ifdef __cplusplus
@@ -88,6 +329,7 @@ void rtc3_spiDriverInit(T_RTC3_P gpioObj, T_RTC3_P spiObj);
 #endif
 #ifdef   __RTC3_DRV_I2C__
 void rtc3_i2cDriverInit(T_RTC3_P gpioObj, T_RTC3_P i2cObj, uint8_t slave);
+void rtc3_ctxI2cDriverInit(rtc3_t *ctx, T_RTC3_P gpioObj, T_RTC3_P i2cObj, uint8_t slave);
 #endif
 #ifdef   __RTC3_DRV_UART__
 void rtc3_uartDriverInit(T_RTC3_P gpioObj, T_RTC3_P uartObj);
@@ -119,6 +361,50 @@ uint8_t rtc3_readByte( uint8_t regAddress );
  */
 void rtc3_writeByte( uint8_t regAddress, uint8_t writeData );
 
+/**
+ * @brief Generic burst read function
+ *
+ * @param[in] startReg                  First register address
+ *
+ * @param[out] pBuf                     Buffer for the read data
+ *
+ * @param[in] nBytes                    Number of registers to read
+ *
+ * @return 0 - read, 1 - bus error, pBuf content undefined
+ *
+ * Function reads a contiguous register range of BQ32000 chip in a single
+ * I2C transaction, using the auto-incrementing register pointer.
+ */
+uint8_t rtc3_readBlock( uint8_t startReg, uint8_t *pBuf, uint8_t nBytes );
+
+/**
+ * @brief Generic burst write function
+ *
+ * @param[in] startReg                  First register address
+ *
+ * @param[in] pBuf                      Buffer with the data to write
+ *
+ * @param[in] nBytes                    Number of registers to write [ 1 - 10 ]
+ *
+ * @return 0 - written, 1 - bus error, the shadow registers are left as
+ * they were
+ *
+ * Function writes a contiguous register range of BQ32000 chip in a single
+ * I2C transaction, using the auto-incrementing register pointer.
+ */
+uint8_t rtc3_writeBlock( uint8_t startReg, uint8_t *pBuf, uint8_t nBytes );
+
+/**
+ * @brief Synchronize configuration shadow registers function
+ *
+ * Function reads CONFIG1 ( 0x07 ), TCH2 ( 0x08 ), CONFIG2 ( 0x09 ) and
+ * SFR ( 0x22 ) into the driver's RAM copies. The copies are filled by
+ * the driver init and kept in sync by every driver write, so the
+ * configuration setters need no read before the write. Call this
+ * function only if the registers could have been changed elsewhere.
+ */
+void rtc3_syncShadow();
+
 /**
  * @brief Enable counting function
  *
@@ -358,6 +644,181 @@ void rtc3_setDate( uint8_t dayOfTheWeek, uint8_t dateDay, uint8_t dateMonth, uin
  */
 void rtc3_getDate( uint8_t *dayOfTheWeek, uint8_t *dateDay, uint8_t *dateMonth, uint16_t *dateYear );
 
+/**
+ * @brief Set date and time function
+ *
+ * @param[in] dateTime                   pointer of date and time data
+ *
+ * Function sets seconds, minutes, hours, day of the week, day, month
+ * and year to the target register address ( 0x00 - 0x06 )
+ * of BQ32000 chip on RTC 3 Click in a single I2C transaction.
+ *
+ * @note Writing the seconds register clears the STOP bit, so counting
+ * is enabled by this function.
+ */
+void rtc3_setDateTime( rtc3_datetime_t *dateTime );
+
+/**
+ * @brief Set date and time on a reference second function
+ *
+ * @param[in] dateTime                   pointer of date and time at refStamp
+ *
+ * @param[in] counter                    free running MCU counter
+ *
+ * @param[in] counterHz                  counter frequency in Hz
+ *
+ * @param[in] refStamp                   counter value at a true second
+ *                                       boundary, e.g. a captured PPS edge
+ *
+ * @param[out] latency                   measured write latency in counter ticks
+ *
+ * @return 0 - written on the boundary, 1 - refStamp in the future or more
+ * than 4 sec old, counter not running or counterHz above 715 MHz,
+ * nothing written
+ *
+ * Function times a read of the seconds register, which rewrites nothing,
+ * and scales it to the bus write up to the seconds byte. It then encodes
+ * the date and time of the next true second boundary still ahead and
+ * writes all seven registers in one transaction that early, so the
+ * seconds byte, which restarts the countdown chain, lands on the boundary.
+ * It blocks until then, up to 1 sec.
+ *
+ * @note Poll a PPS pin and pass the counter value read on its rising
+ * edge within the following 4 sec. Start the sub-second clock again
+ * afterwards.
+ */
+uint8_t rtc3_setDateTimeAligned( rtc3_datetime_t *dateTime, rtc3_counter_t counter, uint32_t counterHz, uint32_t refStamp, uint32_t *latency );
+
+/**
+ * @brief Get date and time function
+ *
+ * @param[out] dateTime                  pointer of date and time data
+ *
+ * Function gets seconds, minutes, hours, day of the week, day, month
+ * and year from the target register address ( 0x00 - 0x06 )
+ * of BQ32000 chip on RTC 3 Click in a single I2C transaction,
+ * so the snapshot can not be torn by a seconds rollover.
+ */
+void rtc3_getDateTime( rtc3_datetime_t *dateTime );
+
+/**
+ * @brief Poll date and time for a change function
+ *
+ * @param[out] dateTime                  pointer of date and time data,
+ *                                       updated only on a change
+ *
+ * @return
+ * - 0 : seconds unchanged since the last poll;
+ * - 1 : date and time changed;
+ *
+ * Function reads only the seconds register ( 0x00 ) and compares it
+ * with the registers kept from the last poll. When a field counted below
+ * its last value it rolled over, so the registers from 0x00 up to the one
+ * the rollover reaches are read again in a single burst, giving a coherent
+ * snapshot. The first poll, and the first one after a time or date write,
+ * reads all seven registers. Poll at least once a minute.
+ */
+uint8_t rtc3_pollChanged( rtc3_datetime_t *dateTime );
+
+/**
+ * @brief Date and time to epoch function
+ *
+ * @param[in] dateTime                   pointer of date and time data,
+ * year as [ 0 - 99 ] or [ 2000 - 2099 ]
+ *
+ * @return Unix time ( seconds since 1970-01-01 00:00:00 UTC )
+ *
+ * Function converts date and time to Unix time in constant time,
+ * without any per-year or per-month loops. Day of the week is ignored.
+ */
+uint32_t rtc3_dateTimeToEpoch( rtc3_datetime_t *dateTime );
+
+/**
+ * @brief Epoch to date and time function
+ *
+ * @param[in] epoch                      Unix time [ _RTC3_EPOCH_MIN - _RTC3_EPOCH_MAX ]
+ * @param[out] dateTime                  pointer of date and time data
+ *
+ * Function converts Unix time to date and time in constant time,
+ * day of the week included. Values outside of years 2000 - 2099
+ * are clamped to the range.
+ */
+void rtc3_epochToDateTime( uint32_t epoch, rtc3_datetime_t *dateTime );
+
+/**
+ * @brief Get epoch function
+ *
+ * @return Unix time ( seconds since 1970-01-01 00:00:00 UTC )
+ *
+ * Function reads the time and date registers ( 0x00 - 0x06 )
+ * of BQ32000 chip on RTC 3 Click in a single I2C transaction
+ * and converts the BCD snapshot to Unix time.
+ */
+uint32_t rtc3_getEpoch();
+
+/**
+ * @brief Set epoch function
+ *
+ * @param[in] epoch                      Unix time [ _RTC3_EPOCH_MIN - _RTC3_EPOCH_MAX ]
+ *
+ * Function sets the time and date registers ( 0x00 - 0x06 )
+ * of BQ32000 chip on RTC 3 Click in a single I2C transaction.
+ * Day of the week is derived from the epoch.
+ */
+void rtc3_setEpoch( uint32_t epoch );
+
+/**
+ * @brief Get raw date and time snapshot function
+ *
+ * @param[out] snapshot                  pointer of snapshot data
+ *
+ * Function reads the time and date registers ( 0x00 - 0x06 )
+ * of BQ32000 chip on RTC 3 Click in a single I2C transaction,
+ * without decoding them.
+ */
+void rtc3_getSnapshot( rtc3_snapshot_t *snapshot );
+
+/**
+ * @brief Decode raw date and time snapshot function
+ *
+ * @param[in] snapshot                   pointer of snapshot data
+ * @param[out] dateTime                  pointer of date and time data
+ */
+void rtc3_decodeSnapshot( rtc3_snapshot_t *snapshot, rtc3_datetime_t *dateTime );
+
+/**
+ * @brief Format ISO 8601 date and time function
+ *
+ * @param[in] snapshot                   pointer of snapshot data
+ * @param[out] pBuf                      pointer of text buffer, at least 20 bytes
+ *
+ * @return Text length, always 19
+ *
+ * Function renders the snapshot as YYYY-MM-DDThh:mm:ss straight from
+ * the BCD nibbles.
+ */
+uint8_t rtc3_formatIso8601( rtc3_snapshot_t *snapshot, char *pBuf );
+
+/**
+ * @brief Format custom date and time function
+ *
+ * @param[in] snapshot                   pointer of snapshot data
+ * @param[in] format                     format string:
+ * - %H, %M, %S : hours, minutes, seconds as two digits;
+ * - %d, %m : day and month as two digits;
+ * - %y, %Y : year as two or four digits;
+ * - %a, %A : short or full weekday name;
+ * - %% : percent sign, other characters are copied;
+ * @param[out] pBuf                      pointer of text buffer
+ * @param[in] bufSize                    size of text buffer
+ *
+ * @return Text length, without the terminating zero
+ *
+ * Function renders the snapshot straight from the BCD nibbles into
+ * one buffer, truncating the text to fit.
+ */
+uint8_t rtc3_formatCustom( rtc3_snapshot_t *snapshot, char *format, char *pBuf, uint8_t bufSize );
+
 /**
  * @brief Set calibration function
  *
@@ -370,9 +831,87 @@ void rtc3_getDate( uint8_t *dayOfTheWeek, uint8_t *dateDay, uint8_t *dateMonth,
  * - negativ: number/245760 ppm
  *
  * Function set calibration by write CAL_CFG1 register of BQ32000 chip.
+ * OUT and FT bits are preserved.
  */
 void rtc3_setCalibration( uint8_t calSign, uint8_t calNumber );
 
+/**
+ * @brief Automatic calibration function
+ *
+ * @param[in] counter                     free running MCU reference counter
+ * @param[in] counterHz                   counter frequency in Hz
+ * @param[in] ftf                         output measured on the IRQ pin
+ * - 0: 512 Hz, raw oscillator;
+ * - 1: 1 Hz, includes the current CAL bits;
+ * @param[in] periods                     measurement window in output periods
+ * @param[out] result                     pointer of calibration result, or 0
+ *
+ * @return 0 - calibration programmed, 1 - no output edges seen, nothing changed
+ *
+ * Function routes the calibration output to the IRQ pin ( SF key
+ * sequence included ), times the given number of periods against the
+ * reference counter, computes the crystal error and writes the CAL
+ * bits that cancel it best to CONFIG1. The previous IRQ pin setup is
+ * restored afterwards. The function blocks for the whole window.
+ *
+ * @note Resolution is one counter tick over the window, e.g. 1 MHz
+ * over 60 periods of 1 Hz resolves 0.017 ppm. The CAL range is
+ * -126 ppm to +63 ppm, larger errors are clamped.
+ */
+uint8_t rtc3_autoCalibrate( rtc3_counter_t counter, uint32_t counterHz, uint8_t ftf, uint16_t periods, rtc3_calibration_t *result );
+
+#ifdef __RTC3_ENABLE_TEMPCOMP__
+/**
+ * @brief Crystal temperature drift function
+ *
+ * @param[in] temperature                 temperature in 0.1 degrees C
+ *
+ * @return Frequency error of a nominal tuning fork crystal at that
+ * temperature relative to the turnover point, ppb ( always <= 0 )
+ *
+ * Function interpolates a table built at compile time from
+ * __RTC3_TC_TURNOVER__ and __RTC3_TC_COEFF_PPB__.
+ * Temperatures are clamped to -40.0 - 86.9 degrees C.
+ */
+int32_t rtc3_tempCompDrift( int16_t temperature );
+
+/**
+ * @brief Crystal offset at turnover function
+ *
+ * @param[in] errorPpb                    crystal error measured by rtc3_autoCalibrate
+ * @param[in] temperature                 temperature during the measurement, 0.1 degrees C
+ *
+ * @return Crystal error with the temperature drift removed, ppb,
+ * suitable for rtc3_tempCompInit
+ */
+int32_t rtc3_tempCompOffset( int32_t errorPpb, int16_t temperature );
+
+/**
+ * @brief Temperature compensation init function
+ *
+ * @param[in] temperature                 temperature reading function, 0 disables compensation
+ * @param[in] offsetPpb                   crystal error at the turnover temperature, ppb
+ * @param[in] period                      rtc3_tempCompService calls between readings
+ *
+ * Function arms the compensation, the next service call takes
+ * a reading and programs the CAL bits.
+ */
+void rtc3_tempCompInit( rtc3_temperature_t temperature, int32_t offsetPpb, uint16_t period );
+
+/**
+ * @brief Temperature compensation service function
+ *
+ * @return 1 - CAL bits were updated, 0 - no change
+ *
+ * Function is meant to be called once per second, for example when
+ * rtc3_tickService returns 1. Every period calls it reads the
+ * temperature, adds the parabolic drift to the crystal offset and
+ * writes CONFIG1 through rtc3_setCalibration, only when the best
+ * CAL bits differ from the programmed ones.
+ */
+uint8_t rtc3_tempCompService();
+#endif
+
 /**
  * @brief Set trickle charge control function
  *
@@ -446,6 +985,40 @@ void rtc3_setSpecialFunctionKey2( uint8_t sfkey2 );
  */
 void rtc3_setFrequencyCalibration( uint8_t ftf );
 
+/**
+ * @brief Set statistics clock function
+ *
+ * @param[in] clockFn                     free running counter used to time
+ *                                        bus transactions, 0 disables timing
+ *
+ * Function sets the counter used for the cycle fields of rtc3_stats_t.
+ * The transaction fields time each START ... STOP on its own, the call
+ * fields time a driver function from entry to return over all of its
+ * transactions and the waits between them. Most calls are a single
+ * transaction, but rtc3_enableCounting, rtc3_disableCounting and
+ * rtc3_syncShadow take two, rtc3_enableCalibrationOutput four and
+ * rtc3_autoCalibrate up to eight around its edge measurement.
+ * An rtc3_*Async transfer counts as one call and one transaction,
+ * timed from its start to the rtc3_poll that completes it.
+ */
+void rtc3_setStatsClock( rtc3_counter_t clockFn );
+
+/**
+ * @brief Get statistics function
+ *
+ * @param[out] stats                      pointer of statistics data
+ *
+ * Function copies the I2C bus statistics gathered by the HAL.
+ */
+void rtc3_getStats( rtc3_stats_t *stats );
+
+/**
+ * @brief Reset statistics function
+ *
+ * Function clears all I2C bus statistics.
+ */
+void rtc3_resetStats();
+
 /**
  * @brief Get state of interrupt pin function
  *
@@ -456,6 +1029,981 @@ void rtc3_setFrequencyCalibration( uint8_t ftf );
  */
 uint8_t rtc3_getInterrupt();
 
+/**
+ * @brief Enable calibration output function
+ *
+ * @param[in] ftf                         frequency of the calibration output
+ * - 0: Normal 512 Hz calibration;
+ * - 1: 1 Hz calibration;
+ *
+ * Function writes the special function keys and FTF to the SFR,
+ * then sets the FT bit in CONFIG1 so the IRQ pin outputs
+ * the calibration signal.
+ */
+void rtc3_enableCalibrationOutput( uint8_t ftf );
+
+/**
+ * @brief Disable calibration output function
+ *
+ * Function clears the FT bit in CONFIG1, IRQ pin follows the OUT bit again.
+ */
+void rtc3_disableCalibrationOutput();
+
+#ifdef __RTC3_ENABLE_CLOCK__
+/**
+ * @brief Start software clock function
+ *
+ * @param[in] counter                     free running MCU counter used for
+ *                                        sub-second interpolation, or 0
+ *
+ * @param[in] counterHz                   counter frequency in Hz
+ *
+ * @param[in] resyncPeriod                seconds between I2C re-syncs,
+ *                                        0 - re-sync only on request
+ *
+ * @return 0 - started, 1 - no rising edge on the INT pin
+ *
+ * Function enables the 1 Hz calibration output, waits for its rising edge
+ * ( up to 1 sec ) and reads the date and time once. From then on the time
+ * is kept in RAM and advanced by rtc3_clockEdge, so rtc3_clockGet
+ * makes no bus traffic. The wait gives up after 2 sec of counter ticks,
+ * or after a fixed number of INT pin reads when counter is 0.
+ */
+uint8_t rtc3_clockStart( rtc3_counter_t counter, uint32_t counterHz, uint16_t resyncPeriod );
+
+/**
+ * @brief Stop software clock function
+ */
+void rtc3_clockStop();
+
+/**
+ * @brief Software clock edge function
+ *
+ * Function advances the software clock by one second.
+ * It is called by the tick service ( rtc3_tickIsr, rtc3_tickService )
+ * on every rising edge of the INT pin. It makes no bus traffic.
+ */
+void rtc3_clockEdge();
+
+/**
+ * @brief Software clock service function
+ *
+ * Function performs a pending re-sync over I2C. Call it from the main loop
+ * when rtc3_clockEdge is called from an interrupt routine.
+ * The new register values are applied on the next edge.
+ */
+void rtc3_clockService();
+
+/**
+ * @brief Software clock re-sync request function
+ *
+ * Function requests a re-sync on the next rtc3_clockService call.
+ */
+void rtc3_clockResync();
+
+/**
+ * @brief Get software clock time function
+ *
+ * @param[out] dateTime                   pointer of date and time data
+ *
+ * @param[out] milliseconds               pointer of milliseconds since the
+ *                                        last edge [ 0 - 999 ], may be 0
+ *
+ * Function returns the RAM copy of the date and time,
+ * without any bus traffic.
+ */
+void rtc3_clockGet( rtc3_datetime_t *dateTime, uint16_t *milliseconds );
+#endif
+
+#ifdef __RTC3_ENABLE_SUBSEC__
+/**
+ * @brief Start sub-second clock function
+ *
+ * @param[in] edgeCounter                 counter of rising edges on the IRQ pin,
+ *                                        e.g. a timer clocked by the pin,
+ *                                        or 0 to count with rtc3_subsecEdge
+ *
+ * @param[in] resyncPeriod                seconds between re-locks done by
+ *                                        rtc3_subsecService, 0 - never
+ *
+ * @return 0 - locked, 1 - no seconds rollover found within about 2 sec,
+ * or no 512 Hz edge counted at all
+ *
+ * Function switches the IRQ pin to the 512 Hz calibration output and
+ * reads the seconds register right behind each edge until it changes.
+ * That edge is the rollover, from then on rtc3_subsecGet counts
+ * edges from it and makes no bus traffic. Every read must complete
+ * within one edge period ( 1.95 ms ). Blocks for up to about 2 sec,
+ * or gives up after about a million edge counter reads without an edge.
+ * Start again after the date or time has been set.
+ *
+ * @note The 512 Hz output does not include the CAL bits, so its rate is
+ * measured between locks and corrected for. The 1 Hz tick service and
+ * the software clock cannot run at the same time, they need FTF set.
+ */
+uint8_t rtc3_subsecStart( rtc3_counter_t edgeCounter, uint16_t resyncPeriod );
+
+/**
+ * @brief Stop sub-second clock function
+ */
+void rtc3_subsecStop();
+
+/**
+ * @brief Sub-second clock edge function
+ *
+ * Function counts one 512 Hz edge. Call it from the external interrupt
+ * routine on the rising edge of INT when rtc3_subsecStart was given
+ * no edge counter.
+ */
+void rtc3_subsecEdge();
+
+/**
+ * @brief Sub-second clock service function
+ *
+ * @return 1 if the clock was re-locked by this call
+ *
+ * Function re-locks to the seconds rollover once resyncPeriod seconds
+ * have passed. It waits for the last few edges before the predicted
+ * rollover, so call it from the main loop at least every few ms; the
+ * lock then polls the bus for about 5 edges ( 10 ms ).
+ */
+uint8_t rtc3_subsecService();
+
+/**
+ * @brief Get sub-second clock time function
+ *
+ * @param[out] fraction                   pointer of 1/512 sec since the
+ *                                        last rollover [ 0 - 511 ], may be 0
+ *
+ * @return Unix time, 0 when the clock is not locked
+ *
+ * Function returns the time from the edge count, without any bus traffic.
+ * Safe to call from interrupt routines.
+ */
+uint32_t rtc3_subsecGet( uint16_t *fraction );
+#endif
+
+/**
+ * @brief Tick service init function
+ *
+ * @param[in] callback                    function called once per second,
+ *                                        or 0 to use rtc3_tickPending only
+ *
+ * Function enables the 1 Hz calibration output on the INT pin and arms
+ * the tick service. Counting must be enabled for the output to run.
+ */
+void rtc3_tickInit( rtc3_tick_t callback );
+
+/**
+ * @brief Tick interrupt function
+ *
+ * Function handles one 1 Hz tick: advances the software clock when it
+ * is enabled and started, sets the pending flag and calls the tick callback.
+ * Call it from the external interrupt routine on the rising edge of INT,
+ * the callback then also runs in interrupt context.
+ */
+void rtc3_tickIsr();
+
+/**
+ * @brief Tick service function
+ *
+ * @return 1 if a tick was handled by this call
+ *
+ * Function samples the INT pin and calls rtc3_tickIsr on a rising edge,
+ * then runs rtc3_clockService when enabled. Call it from the main loop when INT
+ * is not routed to an external interrupt. It makes no bus traffic
+ * unless a software clock re-sync is due.
+ */
+uint8_t rtc3_tickService();
+
+/**
+ * @brief Tick pending function
+ *
+ * @return 1 if a tick occurred since the previous call
+ *
+ * Function returns and clears the tick flag.
+ */
+uint8_t rtc3_tickPending();
+
+#ifdef __RTC3_ENABLE_ASYNC__
+/**
+ * @brief Asynchronous burst read function
+ *
+ * @param[in] startReg                   first register address
+ * @param[out] pBuf                      pointer of read data, valid once done is called
+ * @param[in] nBytes                     number of registers [ 1 - 10 ]
+ * @param[in] done                       callback for the finished transfer, or 0
+ *
+ * @return 0 - transfer started, 1 - another transfer is in progress
+ *
+ * Function starts reading n registers of BQ32000 chip on RTC 3 Click
+ * and returns at once. The transfer is advanced by rtc3_poll.
+ */
+uint8_t rtc3_readBlockAsync( uint8_t startReg, uint8_t *pBuf, uint8_t nBytes, rtc3_done_t done );
+
+/**
+ * @brief Asynchronous burst write function
+ *
+ * @param[in] startReg                   first register address
+ * @param[in] pBuf                       pointer of write data, copied before return
+ * @param[in] nBytes                     number of registers [ 1 - 10 ]
+ * @param[in] done                       callback for the finished transfer, or 0
+ *
+ * @return 0 - transfer started, 1 - another transfer is in progress
+ *
+ * Function starts writing n registers of BQ32000 chip on RTC 3 Click
+ * and returns at once. The transfer is advanced by rtc3_poll.
+ */
+uint8_t rtc3_writeBlockAsync( uint8_t startReg, uint8_t *pBuf, uint8_t nBytes, rtc3_done_t done );
+
+/**
+ * @brief Asynchronous get date and time function
+ *
+ * @param[out] dateTime                  pointer of date and time data, valid once done is called
+ * @param[in] done                       callback for the finished transfer, or 0
+ *
+ * @return 0 - transfer started, 1 - another transfer is in progress
+ *
+ * Function starts the same single transaction read as rtc3_getDateTime
+ * and returns at once. The snapshot is decoded just before done is called.
+ */
+uint8_t rtc3_getDateTimeAsync( rtc3_datetime_t *dateTime, rtc3_done_t done );
+
+/**
+ * @brief Asynchronous set date and time function
+ *
+ * @param[in] dateTime                   pointer of date and time data, encoded before return
+ * @param[in] done                       callback for the finished transfer, or 0
+ *
+ * @return 0 - transfer started, 1 - another transfer is in progress
+ *
+ * Function starts the same single transaction write as rtc3_setDateTime
+ * and returns at once.
+ */
+uint8_t rtc3_setDateTimeAsync( rtc3_datetime_t *dateTime, rtc3_done_t done );
+
+/**
+ * @brief Asynchronous transfer poll function
+ *
+ * Function advances the asynchronous transfer by every bus step the
+ * I2C peripheral has finished, and calls the done callback at the end.
+ * Call it either from the I2C peripheral interrupt or from the main
+ * loop, not from both.
+ *
+ * @note With __HAL_I2C_ASYNC__ undefined the transfer is carried out
+ * by the blocking HAL when it is started, and only the done callback
+ * is left for this function.
+ */
+void rtc3_poll();
+
+/**
+ * @brief Asynchronous transfer busy function
+ *
+ * @return 1 - transfer in progress, 0 - idle
+ */
+uint8_t rtc3_asyncBusy();
+#endif
+
+#ifdef __RTC3_ENABLE_EVENTS__
+/**
+ * @brief Event push function
+ *
+ * @param[in] source                     caller defined event source
+ *
+ * @return 0 - event stored, 1 - ring full, event dropped and counted
+ *
+ * Function timestamps an event with the software clock and stores it,
+ * without any bus traffic, so it may be called from an interrupt.
+ * All pushes must come from one context ( single producer ).
+ *
+ * @note Events pushed while the software clock is stopped carry
+ * epoch 0.
+ */
+uint8_t rtc3_eventPush( uint8_t source );
+
+/**
+ * @brief Event pop function
+ *
+ * @param[out] event                     pointer of event data
+ *
+ * @return 1 - event returned, 0 - ring empty
+ *
+ * Function takes the oldest event. All pops must come from one
+ * context ( single consumer ), normally the main loop.
+ */
+uint8_t rtc3_eventPop( rtc3_event_t *event );
+
+/**
+ * @brief Event count function
+ *
+ * @return Events waiting in the ring
+ */
+uint8_t rtc3_eventCount();
+
+/**
+ * @brief Event overflow count function
+ *
+ * @return Events dropped on a full ring since the driver was initialized
+ */
+uint16_t rtc3_eventOverflows();
+
+/**
+ * @brief Event high water mark function
+ *
+ * @return Largest number of events that were waiting at once
+ */
+uint8_t rtc3_eventHighWater();
+#endif
+
+                                                                       /** @} */
+/** @defgroup RTC3_CTX Instance Functions */                  /** @{ */
+
+/*
+ * Every rtc3_ctx* function below is the instance form of the rtc3_*
+ * function of the same name, which acts on the default instance set up
+ * by rtc3_i2cDriverInit. Instances may sit on different buses, the HAL
+ * is remapped whenever a call moves to another instance.
+ */
+
+/**
+ * @brief Generic read byte of data function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_readByte, on the given instance.
+ */
+uint8_t rtc3_ctxReadByte( rtc3_t *ctx, uint8_t regAddress );
+
+/**
+ * @brief Generic write byte of data function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_writeByte, on the given instance.
+ */
+void rtc3_ctxWriteByte( rtc3_t *ctx, uint8_t regAddress, uint8_t writeData );
+
+/**
+ * @brief Generic burst read function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_readBlock, on the given instance.
+ */
+uint8_t rtc3_ctxReadBlock( rtc3_t *ctx, uint8_t startReg, uint8_t *pBuf, uint8_t nBytes );
+
+/**
+ * @brief Generic burst write function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_writeBlock, on the given instance.
+ */
+uint8_t rtc3_ctxWriteBlock( rtc3_t *ctx, uint8_t startReg, uint8_t *pBuf, uint8_t nBytes );
+
+/**
+ * @brief Synchronize configuration shadow registers function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_syncShadow, on the given instance.
+ */
+void rtc3_ctxSyncShadow( rtc3_t *ctx );
+
+/**
+ * @brief Enable counting function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_enableCounting, on the given instance.
+ */
+void rtc3_ctxEnableCounting( rtc3_t *ctx );
+
+/**
+ * @brief Disable counting function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_disableCounting, on the given instance.
+ */
+void rtc3_ctxDisableCounting( rtc3_t *ctx );
+
+/**
+ * @brief Get seconds function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_getTimeSeconds, on the given instance.
+ */
+uint8_t rtc3_ctxGetTimeSeconds( rtc3_t *ctx );
+
+/**
+ * @brief Set seconds function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_setTimeSeconds, on the given instance.
+ */
+void rtc3_ctxSetTimeSeconds( rtc3_t *ctx, uint8_t seconds );
+
+/**
+ * @brief Get minutes function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_getTimeMinutes, on the given instance.
+ */
+uint8_t rtc3_ctxGetTimeMinutes( rtc3_t *ctx );
+
+/**
+ * @brief Set minutes function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_setTimeMinutes, on the given instance.
+ */
+void rtc3_ctxSetTimeMinutes( rtc3_t *ctx, uint8_t minutes );
+
+/**
+ * @brief Get hours function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_getTimeHours, on the given instance.
+ */
+uint8_t rtc3_ctxGetTimeHours( rtc3_t *ctx );
+
+/**
+ * @brief Set hours function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_setTimeHours, on the given instance.
+ */
+void rtc3_ctxSetTimeHours( rtc3_t *ctx, uint8_t hours );
+
+/**
+ * @brief Get day of the week function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_getDayOfTheWeek, on the given instance.
+ */
+uint8_t rtc3_ctxGetDayOfTheWeek( rtc3_t *ctx );
+
+/**
+ * @brief Set day of the week function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_setDayOfTheWeek, on the given instance.
+ */
+void rtc3_ctxSetDayOfTheWeek( rtc3_t *ctx, uint8_t wDay );
+
+/**
+ * @brief Get day function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_getDateDay, on the given instance.
+ */
+uint8_t rtc3_ctxGetDateDay( rtc3_t *ctx );
+
+/**
+ * @brief Set day function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_setDateDay, on the given instance.
+ */
+void rtc3_ctxSetDateDay( rtc3_t *ctx, uint8_t dateDay );
+
+/**
+ * @brief Get month function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_getDateMonth, on the given instance.
+ */
+uint8_t rtc3_ctxGetDateMonth( rtc3_t *ctx );
+
+/**
+ * @brief Set month function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_setDateMonth, on the given instance.
+ */
+void rtc3_ctxSetDateMonth( rtc3_t *ctx, uint8_t dateMonth );
+
+/**
+ * @brief Get year function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_getDateYear, on the given instance.
+ */
+uint8_t rtc3_ctxGetDateYear( rtc3_t *ctx );
+
+/**
+ * @brief Set year function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_setDateYear, on the given instance.
+ */
+void rtc3_ctxSetDateYear( rtc3_t *ctx, uint16_t dateYear );
+
+/**
+ * @brief Set time hours, minutes and seconds function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_setTime, on the given instance.
+ */
+void rtc3_ctxSetTime( rtc3_t *ctx, uint8_t timeHours, uint8_t timeMinutes, uint8_t timeSeconds );
+
+/**
+ * @brief Get time hours, minutes and seconds function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_getTime, on the given instance.
+ */
+void rtc3_ctxGetTime( rtc3_t *ctx, uint8_t *timeHours, uint8_t *timeMinutes, uint8_t *timeSeconds );
+
+/**
+ * @brief Set date hours, minutes and seconds function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_setDate, on the given instance.
+ */
+void rtc3_ctxSetDate( rtc3_t *ctx, uint8_t dayOfTheWeek, uint8_t dateDay, uint8_t dateMonth, uint16_t dateYear );
+
+/**
+ * @brief Get time hours, minutes and seconds function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_getDate, on the given instance.
+ */
+void rtc3_ctxGetDate( rtc3_t *ctx, uint8_t *dayOfTheWeek, uint8_t *dateDay, uint8_t *dateMonth, uint16_t *dateYear );
+
+/**
+ * @brief Set date and time function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_setDateTime, on the given instance.
+ */
+void rtc3_ctxSetDateTime( rtc3_t *ctx, rtc3_datetime_t *dateTime );
+
+/**
+ * @brief Set date and time on a reference second function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_setDateTimeAligned, on the given instance.
+ */
+uint8_t rtc3_ctxSetDateTimeAligned( rtc3_t *ctx, rtc3_datetime_t *dateTime, rtc3_counter_t counter, uint32_t counterHz, uint32_t refStamp, uint32_t *latency );
+
+/**
+ * @brief Get date and time function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_getDateTime, on the given instance.
+ */
+void rtc3_ctxGetDateTime( rtc3_t *ctx, rtc3_datetime_t *dateTime );
+
+/**
+ * @brief Poll date and time for a change function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_pollChanged, on the given instance.
+ */
+uint8_t rtc3_ctxPollChanged( rtc3_t *ctx, rtc3_datetime_t *dateTime );
+
+/**
+ * @brief Get epoch function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_getEpoch, on the given instance.
+ */
+uint32_t rtc3_ctxGetEpoch( rtc3_t *ctx );
+
+/**
+ * @brief Set epoch function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_setEpoch, on the given instance.
+ */
+void rtc3_ctxSetEpoch( rtc3_t *ctx, uint32_t epoch );
+
+/**
+ * @brief Get raw date and time snapshot function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_getSnapshot, on the given instance.
+ */
+void rtc3_ctxGetSnapshot( rtc3_t *ctx, rtc3_snapshot_t *snapshot );
+
+/**
+ * @brief Set calibration function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_setCalibration, on the given instance.
+ */
+void rtc3_ctxSetCalibration( rtc3_t *ctx, uint8_t calSign, uint8_t calNumber );
+
+/**
+ * @brief Automatic calibration function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_autoCalibrate, on the given instance.
+ */
+uint8_t rtc3_ctxAutoCalibrate( rtc3_t *ctx, rtc3_counter_t counter, uint32_t counterHz, uint8_t ftf, uint16_t periods, rtc3_calibration_t *result );
+
+#ifdef __RTC3_ENABLE_TEMPCOMP__
+/**
+ * @brief Temperature compensation init function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_tempCompInit, on the given instance.
+ */
+void rtc3_ctxTempCompInit( rtc3_t *ctx, rtc3_temperature_t temperature, int32_t offsetPpb, uint16_t period );
+
+/**
+ * @brief Temperature compensation service function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_tempCompService, on the given instance.
+ */
+uint8_t rtc3_ctxTempCompService( rtc3_t *ctx );
+#endif
+
+/**
+ * @brief Set trickle charge control function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_setTrickleCharge, on the given instance.
+ */
+void rtc3_ctxSetTrickleCharge( rtc3_t *ctx, uint8_t tch2 );
+
+/**
+ * @brief Set trickle charge bypass control function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_setTrickleChargeBypass, on the given instance.
+ */
+void rtc3_ctxSetTrickleChargeBypass( rtc3_t *ctx, uint8_t tcfe );
+
+/**
+ * @brief Set special function key byte 1 function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_setSpecialFunctionKey1, on the given instance.
+ */
+void rtc3_ctxSetSpecialFunctionKey1( rtc3_t *ctx, uint8_t sfkey1 );
+
+/**
+ * @brief Set special function key byte 2 function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_setSpecialFunctionKey2, on the given instance.
+ */
+void rtc3_ctxSetSpecialFunctionKey2( rtc3_t *ctx, uint8_t sfkey2 );
+
+/**
+ * @brief Set frequency calibration control function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_setFrequencyCalibration, on the given instance.
+ */
+void rtc3_ctxSetFrequencyCalibration( rtc3_t *ctx, uint8_t ftf );
+
+/**
+ * @brief Get state of interrupt pin function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_getInterrupt, on the given instance.
+ */
+uint8_t rtc3_ctxGetInterrupt( rtc3_t *ctx );
+
+/**
+ * @brief Enable calibration output function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_enableCalibrationOutput, on the given instance.
+ */
+void rtc3_ctxEnableCalibrationOutput( rtc3_t *ctx, uint8_t ftf );
+
+/**
+ * @brief Disable calibration output function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_disableCalibrationOutput, on the given instance.
+ */
+void rtc3_ctxDisableCalibrationOutput( rtc3_t *ctx );
+
+#ifdef __RTC3_ENABLE_CLOCK__
+/**
+ * @brief Start software clock function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_clockStart, on the given instance.
+ */
+uint8_t rtc3_ctxClockStart( rtc3_t *ctx, rtc3_counter_t counter, uint32_t counterHz, uint16_t resyncPeriod );
+
+/**
+ * @brief Stop software clock function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_clockStop, on the given instance.
+ */
+void rtc3_ctxClockStop( rtc3_t *ctx );
+
+/**
+ * @brief Software clock edge function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_clockEdge, on the given instance.
+ */
+void rtc3_ctxClockEdge( rtc3_t *ctx );
+
+/**
+ * @brief Software clock service function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_clockService, on the given instance.
+ */
+void rtc3_ctxClockService( rtc3_t *ctx );
+
+/**
+ * @brief Software clock re-sync request function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_clockResync, on the given instance.
+ */
+void rtc3_ctxClockResync( rtc3_t *ctx );
+
+/**
+ * @brief Get software clock time function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_clockGet, on the given instance.
+ */
+void rtc3_ctxClockGet( rtc3_t *ctx, rtc3_datetime_t *dateTime, uint16_t *milliseconds );
+#endif
+
+#ifdef __RTC3_ENABLE_SUBSEC__
+/**
+ * @brief Start sub-second clock function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_subsecStart, on the given instance.
+ */
+uint8_t rtc3_ctxSubsecStart( rtc3_t *ctx, rtc3_counter_t edgeCounter, uint16_t resyncPeriod );
+
+/**
+ * @brief Stop sub-second clock function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_subsecStop, on the given instance.
+ */
+void rtc3_ctxSubsecStop( rtc3_t *ctx );
+
+/**
+ * @brief Sub-second clock edge function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_subsecEdge, on the given instance.
+ */
+void rtc3_ctxSubsecEdge( rtc3_t *ctx );
+
+/**
+ * @brief Sub-second clock service function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_subsecService, on the given instance.
+ */
+uint8_t rtc3_ctxSubsecService( rtc3_t *ctx );
+
+/**
+ * @brief Get sub-second clock time function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_subsecGet, on the given instance.
+ */
+uint32_t rtc3_ctxSubsecGet( rtc3_t *ctx, uint16_t *fraction );
+#endif
+
+/**
+ * @brief Tick service init function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_tickInit, on the given instance.
+ */
+void rtc3_ctxTickInit( rtc3_t *ctx, rtc3_tick_t callback );
+
+/**
+ * @brief Tick interrupt function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_tickIsr, on the given instance.
+ */
+void rtc3_ctxTickIsr( rtc3_t *ctx );
+
+/**
+ * @brief Tick service function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_tickService, on the given instance.
+ */
+uint8_t rtc3_ctxTickService( rtc3_t *ctx );
+
+/**
+ * @brief Tick pending function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_tickPending, on the given instance.
+ */
+uint8_t rtc3_ctxTickPending( rtc3_t *ctx );
+
+#ifdef __RTC3_ENABLE_ASYNC__
+/**
+ * @brief Asynchronous burst read function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_readBlockAsync, on the given instance.
+ */
+uint8_t rtc3_ctxReadBlockAsync( rtc3_t *ctx, uint8_t startReg, uint8_t *pBuf, uint8_t nBytes, rtc3_done_t done );
+
+/**
+ * @brief Asynchronous burst write function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_writeBlockAsync, on the given instance.
+ */
+uint8_t rtc3_ctxWriteBlockAsync( rtc3_t *ctx, uint8_t startReg, uint8_t *pBuf, uint8_t nBytes, rtc3_done_t done );
+
+/**
+ * @brief Asynchronous get date and time function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_getDateTimeAsync, on the given instance.
+ */
+uint8_t rtc3_ctxGetDateTimeAsync( rtc3_t *ctx, rtc3_datetime_t *dateTime, rtc3_done_t done );
+
+/**
+ * @brief Asynchronous set date and time function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_setDateTimeAsync, on the given instance.
+ */
+uint8_t rtc3_ctxSetDateTimeAsync( rtc3_t *ctx, rtc3_datetime_t *dateTime, rtc3_done_t done );
+
+/**
+ * @brief Asynchronous transfer poll function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_poll, on the given instance.
+ */
+void rtc3_ctxPoll( rtc3_t *ctx );
+
+/**
+ * @brief Asynchronous transfer busy function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_asyncBusy, on the given instance.
+ */
+uint8_t rtc3_ctxAsyncBusy( rtc3_t *ctx );
+#endif
+
+#ifdef __RTC3_ENABLE_EVENTS__
+/**
+ * @brief Event push function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_eventPush, on the given instance.
+ */
+uint8_t rtc3_ctxEventPush( rtc3_t *ctx, uint8_t source );
+
+/**
+ * @brief Event pop function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_eventPop, on the given instance.
+ */
+uint8_t rtc3_ctxEventPop( rtc3_t *ctx, rtc3_event_t *event );
+
+/**
+ * @brief Event count function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_eventCount, on the given instance.
+ */
+uint8_t rtc3_ctxEventCount( rtc3_t *ctx );
+
+/**
+ * @brief Event overflow count function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_eventOverflows, on the given instance.
+ */
+uint16_t rtc3_ctxEventOverflows( rtc3_t *ctx );
+
+/**
+ * @brief Event high water mark function ( instance )
+ *
+ * @param[in] ctx                        driver instance
+ *
+ * Same as rtc3_eventHighWater, on the given instance.
+ */
+uint8_t rtc3_ctxEventHighWater( rtc3_t *ctx );
+#endif
 
 
 
@@ -46,6 +46,34 @@
 //                #define   __HAL_SPI__                            /**<     @macro __HAL_SPI__  @brief SPI HAL selector */                
                  #define   __HAL_I2C__                            /**<     @macro __HAL_I2C__  @brief I2C HAL selector */
 //               #define   __HAL_UART__                           /**<     @macro __HAL_UART__  @brief UART HAL selector */                          
+//               #define   __HAL_HOST__                           /**<     @macro __HAL_HOST__  @brief Host ( Linux/gcc ) simulated HAL selector */
+//               #define   __HAL_LINUX__                          /**<     @macro __HAL_LINUX__  @brief Linux i2c-dev userspace HAL selector */
+//               #define   __HAL_STATS__                          /**<     @macro __HAL_STATS__  @brief I2C bus statistics selector */
+//               #define   __HAL_I2C_ASYNC__                      /**<     @macro __HAL_I2C_ASYNC__  @brief Interrupt driven I2C selector */
+//               #define   __HAL_I2C_DMA__                        /**<     @macro __HAL_I2C_DMA__  @brief DMA I2C transfer selector */
+//               #define   __HAL_STATIC__                         /**<     @macro __HAL_STATIC__  @brief Compile-time HAL binding selector */
+
+// With __HAL_STATIC__ the bus and pins are bound by name instead of through the
+// mikroBUS objects, on the host and on mikroC PRO for ARM only :
+//
+// #define   __HAL_STATIC_I2C_START__  I2C1_Start
+// #define   __HAL_STATIC_I2C_WRITE__  I2C1_Write
+// #define   __HAL_STATIC_I2C_READ__   I2C1_Read
+// #define   __HAL_STATIC_INT_GET__    rtc3_intPinGet
+
+// __HAL_I2C_ASYNC__ and __HAL_I2C_DMA__ run on the simulator on the host,
+// elsewhere the application provides the peripheral functions, e.g. :
+//
+// #define   __HAL_I2C_ASYNC_START__   app_i2cAsyncStart
+// #define   __HAL_I2C_ASYNC_WRITE__   app_i2cAsyncWrite
+// #define   __HAL_I2C_ASYNC_READ__    app_i2cAsyncRead
+// #define   __HAL_I2C_ASYNC_STOP__    app_i2cAsyncStop
+// #define   __HAL_I2C_ASYNC_DONE__    app_i2cAsyncDone
+// #define   __HAL_I2C_ASYNC_RESULT__  app_i2cAsyncResult
+//
+// #define   __HAL_I2C_DMA_TRANSFER__  app_i2cDmaTransfer
+// #define   __HAL_I2C_DMA_DONE__      app_i2cDmaDone
+// #define   __HAL_I2C_DMA_ERROR__     app_i2cDmaError
 
 // #define   __AN_PIN_INPUT__          0
 // #define   __RST_PIN_INPUT__         1
@@ -192,6 +220,115 @@ static int hal_i2cRead(uint8_t slaveAddress, uint8_t *pBuf, uint16_t nBytes, uin
 
                                                                        /** @} */
 #endif
+#if defined( __HAL_I2C_ASYNC__ ) && defined( __HAL_I2C__ )
+
+/** @defgroup RTC3_HAL_I2C_ASYNC HAL I2C Asynchronous Interface */ /** @{ */
+
+// Host : the simulated peripheral, other targets : the application
+// functions named by __HAL_I2C_ASYNC_START__ ... __HAL_I2C_ASYNC_RESULT__,
+// with the same signatures
+
+/**
+ * @brief hal_i2cAsyncStart
+ *
+ * Function begins a start, or repeated start, condition on I2C BUS
+ * and returns without waiting for it.
+ */
+static void hal_i2cAsyncStart(void);
+
+/**
+ * @brief hal_i2cAsyncWrite
+ *
+ * @param[in] dataByte         address or data byte
+ *
+ * Function begins a single byte write and returns without waiting for it.
+ */
+static void hal_i2cAsyncWrite(uint8_t dataByte);
+
+/**
+ * @brief hal_i2cAsyncRead
+ *
+ * @param[in] ack              1 - ACK the byte, 0 - NACK
+ *
+ * Function begins a single byte read and returns without waiting for it.
+ */
+static void hal_i2cAsyncRead(uint8_t ack);
+
+/**
+ * @brief hal_i2cAsyncStop
+ *
+ * Function begins a stop condition and returns without waiting for it.
+ */
+static void hal_i2cAsyncStop(void);
+
+/**
+ * @brief hal_i2cAsyncDone
+ *
+ * @return    1                last operation completed
+ *
+ * Function should read the completion flag of the I2C peripheral, the
+ * same flag that raises its interrupt.
+ */
+static uint8_t hal_i2cAsyncDone(void);
+
+/**
+ * @brief hal_i2cAsyncResult
+ *
+ * @return ACK of the last write ( 1 - ACK ) or the last byte read
+ */
+static uint8_t hal_i2cAsyncResult(void);
+
+                                                                       /** @} */
+#endif
+#if defined( __HAL_I2C_DMA__ ) && defined( __HAL_I2C__ )
+
+/** @defgroup RTC3_HAL_I2C_DMA HAL I2C DMA Interface */       /** @{ */
+
+// Host : the simulated DMA channel, other targets : the application
+// functions named by __HAL_I2C_DMA_TRANSFER__, __HAL_I2C_DMA_DONE__ and
+// __HAL_I2C_DMA_ERROR__, with the same signatures
+
+/**
+ * @brief hal_i2cDmaTransfer
+ *
+ * @param[in] slaveAddress     7 bit slave addres without 0 bit (read/write bit)
+ * @param[in] pWrite           pointer to write data buffer
+ * @param[in] nWrite           number of bytes for writing
+ * @param[out] pRead           pointer to read data buffer
+ * @param[in] nRead            number of bytes to read, 0 for a write only
+ *
+ * @return    0                Transfer queued
+ *
+ * Function should queue a complete transaction to the DMA controller
+ * and return at once. Buffers stay owned by the DMA until
+ * hal_i2cDmaDone returns 1.
+ *
+ * |       8 Bits      | Write ( nWrite ) | Restart + 8 Bits  | Read ( nRead ) | End  |
+ * |:-----------------:|:----------------:|:-----------------:|:--------------:|:----:|
+ * | Slave Address + W | Data Bytes       | Slave Address + R | Data Bytes     | Stop |
+ *
+ * @note
+ * Any non-zero return ( no free channel, transfer too long ... )
+ * makes the driver fall back to the byte by byte path.
+ */
+static int hal_i2cDmaTransfer(uint8_t slaveAddress, uint8_t *pWrite, uint16_t nWrite, uint8_t *pRead, uint16_t nRead);
+
+/**
+ * @brief hal_i2cDmaDone
+ *
+ * @return    1                queued transfer finished, STOP included
+ */
+static uint8_t hal_i2cDmaDone(void);
+
+/**
+ * @brief hal_i2cDmaError
+ *
+ * @return    0                last transfer was ACKed all the way
+ */
+static uint8_t hal_i2cDmaError(void);
+
+                                                                       /** @} */
+#endif
 #ifdef __HAL_UART__
 
 /** @defgroup RTC3_HAL_UART HAL UART Interface */             /** @{ */
@@ -242,6 +379,8 @@ typedef struct
   
 }T_hal_gpioObj;
 
+#ifndef __HAL_STATIC__
+
 #ifdef __AN_PIN_INPUT__
 static T_hal_gpioGetFp          hal_gpio_anGet; 
 #endif
@@ -395,7 +534,35 @@ static void hal_gpioMap(T_HAL_P gpioObj)
     hal_gpio_sdaSet = tmp->gpioSet[ __SDA_PIN_OUTPUT__ ];
 #endif
 }
+
+#else
+
+#ifdef __INT_PIN_INPUT__
+#define hal_gpio_intGet     __HAL_STATIC_INT_GET__
+#endif
+
+/**
+ * @brief Map GPIO Function pointers
+ *
+ * Pins are bound at compile time, there is nothing to map.
+ */
+static void hal_gpioMap(T_HAL_P gpioObj)
+{
+    (void)gpioObj;
+}
+
+#endif
                                                                        /** @} */
+#ifdef __HAL_HOST__
+#include "__HAL_HOST.c"
+#endif
+
+#ifndef __HAL_STATIC__
+
+#ifdef __HAL_LINUX__
+#include "__HAL_LINUX.c"
+#endif
+
 #ifdef __MIKROC_PRO_FOR_PIC__
 #include "__HAL_PIC.c"
 #endif
@@ -448,6 +615,458 @@ static void hal_gpioMap(T_HAL_P gpioObj)
 #endif
 #endif
 
+#endif
+
+#if defined( __HAL_STATIC__ ) && defined( __HAL_I2C__ )
+
+/** @defgroup RTC3_HAL_STATIC HAL I2C Static Binding */       /** @{ */
+
+// The bound functions must take ( slave, buffer, count, end mode ) like the
+// mapped HAL, with END_MODE_RESTART / END_MODE_STOP from the same library :
+// the host simulator, or the I2Cx_Start / I2Cx_Write / I2Cx_Read library of
+// mikroC PRO for ARM. The PIC, dsPIC, PIC32 and AVR libraries move one byte
+// per call and FT90x takes a register argument, so they use the mapped HAL.
+#if !defined( __HAL_HOST__ ) && !defined( __MIKROC_PRO_FOR_ARM__ )
+#error "__HAL_STATIC__ : not supported on this architecture, use the mapped HAL"
+#endif
+
+#if !defined( __HAL_STATIC_I2C_START__ ) || !defined( __HAL_STATIC_I2C_WRITE__ ) || !defined( __HAL_STATIC_I2C_READ__ )
+#error "__HAL_STATIC__ : define __HAL_STATIC_I2C_START__, __HAL_STATIC_I2C_WRITE__ and __HAL_STATIC_I2C_READ__"
+#endif
+#if defined( __INT_PIN_INPUT__ ) && !defined( __HAL_STATIC_INT_GET__ )
+#error "__HAL_STATIC__ : define __HAL_STATIC_INT_GET__ for the INT pin"
+#endif
+
+/**
+ * @brief Map I2C Function Pointers
+ *
+ * Bus is bound at compile time, there is nothing to map.
+ */
+static void hal_i2cMap(T_HAL_P i2cObj)
+{
+    (void)i2cObj;
+}
+
+static int hal_i2cStart(void)
+{
+    return __HAL_STATIC_I2C_START__();
+}
+
+static int hal_i2cWrite(uint8_t slaveAddress, uint8_t *pBuf, uint16_t nBytes, uint8_t endMode)
+{
+    return __HAL_STATIC_I2C_WRITE__( slaveAddress, pBuf, nBytes, endMode );
+}
+
+static int hal_i2cRead(uint8_t slaveAddress, uint8_t *pBuf, uint16_t nBytes, uint8_t endMode)
+{
+    return __HAL_STATIC_I2C_READ__( slaveAddress, pBuf, nBytes, endMode );
+}
+
+                                                                       /** @} */
+#endif
+
+#if defined( __HAL_I2C_ASYNC__ ) && defined( __HAL_I2C__ ) && !defined( __HAL_HOST__ )
+
+/** @defgroup RTC3_HAL_I2C_ASYNC_APP HAL I2C Asynchronous Application Binding */ /** @{ */
+
+#ifndef __HAL_I2C_ASYNC_START__
+#error "__HAL_I2C_ASYNC__ : define __HAL_I2C_ASYNC_START__, void f( void )"
+#endif
+#ifndef __HAL_I2C_ASYNC_WRITE__
+#error "__HAL_I2C_ASYNC__ : define __HAL_I2C_ASYNC_WRITE__, void f( uint8_t dataByte )"
+#endif
+#ifndef __HAL_I2C_ASYNC_READ__
+#error "__HAL_I2C_ASYNC__ : define __HAL_I2C_ASYNC_READ__, void f( uint8_t ack )"
+#endif
+#ifndef __HAL_I2C_ASYNC_STOP__
+#error "__HAL_I2C_ASYNC__ : define __HAL_I2C_ASYNC_STOP__, void f( void )"
+#endif
+#ifndef __HAL_I2C_ASYNC_DONE__
+#error "__HAL_I2C_ASYNC__ : define __HAL_I2C_ASYNC_DONE__, uint8_t f( void )"
+#endif
+#ifndef __HAL_I2C_ASYNC_RESULT__
+#error "__HAL_I2C_ASYNC__ : define __HAL_I2C_ASYNC_RESULT__, uint8_t f( void )"
+#endif
+
+extern void __HAL_I2C_ASYNC_START__(void);
+extern void __HAL_I2C_ASYNC_WRITE__(uint8_t dataByte);
+extern void __HAL_I2C_ASYNC_READ__(uint8_t ack);
+extern void __HAL_I2C_ASYNC_STOP__(void);
+extern uint8_t __HAL_I2C_ASYNC_DONE__(void);
+extern uint8_t __HAL_I2C_ASYNC_RESULT__(void);
+
+static void hal_i2cAsyncStart(void)
+{
+    __HAL_I2C_ASYNC_START__();
+}
+
+static void hal_i2cAsyncWrite(uint8_t dataByte)
+{
+    __HAL_I2C_ASYNC_WRITE__( dataByte );
+}
+
+static void hal_i2cAsyncRead(uint8_t ack)
+{
+    __HAL_I2C_ASYNC_READ__( ack );
+}
+
+static void hal_i2cAsyncStop(void)
+{
+    __HAL_I2C_ASYNC_STOP__();
+}
+
+static uint8_t hal_i2cAsyncDone(void)
+{
+    return __HAL_I2C_ASYNC_DONE__();
+}
+
+static uint8_t hal_i2cAsyncResult(void)
+{
+    return __HAL_I2C_ASYNC_RESULT__();
+}
+
+                                                                       /** @} */
+#endif
+
+#if defined( __HAL_I2C_DMA__ ) && defined( __HAL_I2C__ ) && !defined( __HAL_HOST__ )
+
+/** @defgroup RTC3_HAL_I2C_DMA_APP HAL I2C DMA Application Binding */ /** @{ */
+
+#ifndef __HAL_I2C_DMA_TRANSFER__
+#error "__HAL_I2C_DMA__ : define __HAL_I2C_DMA_TRANSFER__, int f( uint8_t slaveAddress, uint8_t *pWrite, uint16_t nWrite, uint8_t *pRead, uint16_t nRead )"
+#endif
+#ifndef __HAL_I2C_DMA_DONE__
+#error "__HAL_I2C_DMA__ : define __HAL_I2C_DMA_DONE__, uint8_t f( void )"
+#endif
+#ifndef __HAL_I2C_DMA_ERROR__
+#error "__HAL_I2C_DMA__ : define __HAL_I2C_DMA_ERROR__, uint8_t f( void )"
+#endif
+
+extern int __HAL_I2C_DMA_TRANSFER__(uint8_t slaveAddress, uint8_t *pWrite, uint16_t nWrite, uint8_t *pRead, uint16_t nRead);
+extern uint8_t __HAL_I2C_DMA_DONE__(void);
+extern uint8_t __HAL_I2C_DMA_ERROR__(void);
+
+static int hal_i2cDmaTransfer(uint8_t slaveAddress, uint8_t *pWrite, uint16_t nWrite, uint8_t *pRead, uint16_t nRead)
+{
+    return __HAL_I2C_DMA_TRANSFER__( slaveAddress, pWrite, nWrite, pRead, nRead );
+}
+
+static uint8_t hal_i2cDmaDone(void)
+{
+    return __HAL_I2C_DMA_DONE__();
+}
+
+static uint8_t hal_i2cDmaError(void)
+{
+    return __HAL_I2C_DMA_ERROR__();
+}
+
+                                                                       /** @} */
+#endif
+
+#if defined( __HAL_STATS__ ) && defined( __HAL_I2C__ )
+
+/** @defgroup RTC3_HAL_STATS HAL I2C Bus Statistics */        /** @{ */
+
+typedef uint32_t (*T_hal_statsClockFp)();
+
+typedef struct
+{
+    uint32_t    starts;
+    uint32_t    restarts;
+    uint32_t    stops;
+    uint32_t    bytesWritten;
+    uint32_t    bytesRead;
+    uint32_t    errors;
+    uint32_t    transactions;
+    uint32_t    cycles;
+    uint32_t    lastCycles;
+    uint32_t    maxCycles;
+    uint32_t    calls;
+    uint32_t    callCycles;
+    uint32_t    lastCallCycles;
+    uint32_t    maxCallCycles;
+    uint32_t    lastCallTransactions;
+    uint32_t    maxCallTransactions;
+
+}T_hal_stats;
+
+static T_hal_stats          hal_stats;
+static T_hal_statsClockFp   hal_statsClock;
+static uint32_t             hal_statsStamp;
+static uint8_t              hal_statsDepth;
+static uint32_t             hal_statsCallStamp;
+static uint32_t             hal_statsCallFirst;
+static uint8_t              hal_statsAsyncPending;
+static uint32_t             hal_statsAsyncStamp;
+
+/**
+ * @brief Map statistics clock
+ *
+ * @param[in] clockFp          free running cycle counter, or 0 to disable
+ *                             cycle accounting
+ */
+static void hal_statsMap(T_hal_statsClockFp clockFp)
+{
+    hal_statsClock = clockFp;
+}
+
+/**
+ * @brief Reset statistics
+ */
+static void hal_statsReset()
+{
+    hal_stats.starts = 0;
+    hal_stats.restarts = 0;
+    hal_stats.stops = 0;
+    hal_stats.bytesWritten = 0;
+    hal_stats.bytesRead = 0;
+    hal_stats.errors = 0;
+    hal_stats.transactions = 0;
+    hal_stats.cycles = 0;
+    hal_stats.lastCycles = 0;
+    hal_stats.maxCycles = 0;
+    hal_stats.calls = 0;
+    hal_stats.callCycles = 0;
+    hal_stats.lastCallCycles = 0;
+    hal_stats.maxCallCycles = 0;
+    hal_stats.lastCallTransactions = 0;
+    hal_stats.maxCallTransactions = 0;
+}
+
+static uint32_t hal_statsElapsed(uint32_t stamp)
+{
+    if ( hal_statsClock == 0 )
+    {
+        return 0;
+    }
+
+    return hal_statsClock() - stamp;
+}
+
+static void hal_statsCall(uint32_t elapsed, uint32_t transactions)
+{
+    hal_stats.calls++;
+    hal_stats.callCycles += elapsed;
+    hal_stats.lastCallCycles = elapsed;
+    hal_stats.lastCallTransactions = transactions;
+
+    if ( elapsed > hal_stats.maxCallCycles )
+    {
+        hal_stats.maxCallCycles = elapsed;
+    }
+
+    if ( transactions > hal_stats.maxCallTransactions )
+    {
+        hal_stats.maxCallTransactions = transactions;
+    }
+}
+
+/**
+ * @brief Driver call entry
+ *
+ * Calls nest, only the outermost begin / end pair is accounted,
+ * over all the transactions made in between.
+ */
+static void hal_statsCallBegin()
+{
+    if ( hal_statsDepth++ != 0 )
+    {
+        return;
+    }
+
+    hal_statsCallFirst = hal_stats.transactions;
+
+    if ( hal_statsClock != 0 )
+    {
+        hal_statsCallStamp = hal_statsClock();
+    }
+}
+
+/**
+ * @brief Driver call exit
+ */
+static void hal_statsCallEnd()
+{
+    if ( --hal_statsDepth != 0 )
+    {
+        return;
+    }
+
+    hal_statsCall( hal_statsElapsed( hal_statsCallStamp ), hal_stats.transactions - hal_statsCallFirst );
+}
+
+#if defined( __HAL_I2C_ASYNC__ ) || defined( __HAL_I2C_DMA__ )
+/**
+ * @brief Asynchronous transfer start
+ *
+ * The interrupt driven and DMA transfers do not go through the
+ * wrappers below, they are accounted as a whole on completion.
+ */
+static void hal_statsAsyncBegin()
+{
+    hal_statsAsyncPending = 1;
+
+    if ( hal_statsClock != 0 )
+    {
+        hal_statsAsyncStamp = hal_statsClock();
+    }
+}
+#endif
+
+/**
+ * @brief Asynchronous transfer completion
+ *
+ * @param[in] read             1 - pointer write, restart and read, 0 - write
+ * @param[in] nBytes           data bytes of the transfer
+ * @param[in] error            transfer ended on a NACK / error
+ */
+static void hal_statsAsyncEnd(uint8_t read, uint16_t nBytes, uint8_t error)
+{
+    uint32_t elapsed;
+
+    if ( hal_statsAsyncPending == 0 )
+    {
+        return;
+    }
+
+    hal_statsAsyncPending = 0;
+
+    hal_stats.starts++;
+    hal_stats.stops++;
+    hal_stats.transactions++;
+
+    if ( read )
+    {
+        // Address, register pointer and address again
+        hal_stats.restarts++;
+        hal_stats.bytesWritten += 3;
+        hal_stats.bytesRead += nBytes;
+    }
+    else
+    {
+        hal_stats.bytesWritten += nBytes + 2;
+    }
+
+    if ( error != 0 )
+    {
+        hal_stats.errors++;
+    }
+
+    elapsed = hal_statsElapsed( hal_statsAsyncStamp );
+
+    hal_stats.cycles += elapsed;
+    hal_stats.lastCycles = elapsed;
+
+    if ( elapsed > hal_stats.maxCycles )
+    {
+        hal_stats.maxCycles = elapsed;
+    }
+
+    hal_statsCall( elapsed, 1 );
+}
+
+static void hal_statsEnd(uint8_t endMode)
+{
+    uint32_t elapsed;
+
+    if ( endMode == END_MODE_RESTART )
+    {
+        hal_stats.restarts++;
+        return;
+    }
+
+    hal_stats.stops++;
+    hal_stats.transactions++;
+
+    if ( hal_statsClock != 0 )
+    {
+        elapsed = hal_statsClock() - hal_statsStamp;
+
+        hal_stats.cycles += elapsed;
+        hal_stats.lastCycles = elapsed;
+
+        if ( elapsed > hal_stats.maxCycles )
+        {
+            hal_stats.maxCycles = elapsed;
+        }
+    }
+}
+
+static int hal_statsI2cStart(void)
+{
+    int err;
+
+    if ( hal_statsClock != 0 )
+    {
+        hal_statsStamp = hal_statsClock();
+    }
+
+    err = hal_i2cStart();
+
+    hal_stats.starts++;
+
+    if ( err != 0 )
+    {
+        hal_stats.errors++;
+    }
+
+    return err;
+}
+
+static int hal_statsI2cWrite(uint8_t slaveAddress, uint8_t *pBuf, uint16_t nBytes, uint8_t endMode)
+{
+    int err;
+
+    err = hal_i2cWrite( slaveAddress, pBuf, nBytes, endMode );
+
+    // Address byte is counted as a written byte
+    hal_stats.bytesWritten += nBytes + 1;
+
+    if ( err != 0 )
+    {
+        hal_stats.errors++;
+    }
+
+    hal_statsEnd( endMode );
+
+    return err;
+}
+
+static int hal_statsI2cRead(uint8_t slaveAddress, uint8_t *pBuf, uint16_t nBytes, uint8_t endMode)
+{
+    int err;
+
+    err = hal_i2cRead( slaveAddress, pBuf, nBytes, endMode );
+
+    hal_stats.bytesWritten++;
+    hal_stats.bytesRead += nBytes;
+
+    if ( err != 0 )
+    {
+        hal_stats.errors++;
+    }
+
+    hal_statsEnd( endMode );
+
+    return err;
+}
+
+// Route every driver bus call through the counting wrappers
+#define hal_i2cStart    hal_statsI2cStart
+#define hal_i2cWrite    hal_statsI2cWrite
+#define hal_i2cRead     hal_statsI2cRead
+
+                                                                       /** @} */
+#else
+
+#define hal_statsCallBegin()
+#define hal_statsCallEnd()
+#define hal_statsAsyncBegin()
+#define hal_statsAsyncEnd(read, nBytes, error)
+
+#endif
+
 /* -------------------------------------------------------------------------- */
 /*
   __rtc3_hal.c
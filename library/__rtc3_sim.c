@@ -0,0 +1,936 @@
+/*
+    __rtc3_sim.c
+
+-----------------------------------------------------------------------------
+
+  This file is part of mikroSDK.
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+----------------------------------------------------------------------------- */
+
+#include "__rtc3_sim.h"
+
+#ifdef __linux__
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#endif
+
+/* ------------------------------------------------------------------- MACROS */
+
+#define _RTC3SIM_REG_COUNT                                                10
+#define _RTC3SIM_NS_PER_SECOND                                            1000000000UL
+
+#define _RTC3SIM_BUS_IDLE                                                 0
+#define _RTC3SIM_BUS_ADDRESS                                              1
+#define _RTC3SIM_BUS_POINTER                                              2
+#define _RTC3SIM_BUS_WRITE                                                3
+#define _RTC3SIM_BUS_READ                                                 4
+#define _RTC3SIM_BUS_IGNORE                                               5
+
+// Default bus timing, 100 kHz SCL without clock stretching
+#define _RTC3SIM_SCL_HZ                                                   100000UL
+#define _RTC3SIM_STRETCH_NS                                               0
+
+#define _RTC3SIM_I2C_OP_NONE                                              0
+#define _RTC3SIM_I2C_OP_START                                             1
+#define _RTC3SIM_I2C_OP_WRITE                                             2
+#define _RTC3SIM_I2C_OP_READ                                              3
+#define _RTC3SIM_I2C_OP_STOP                                              4
+
+// Tuning fork crystal: -0.034 ppm / C^2 around a 25.0 C turnover
+#define _RTC3SIM_XTAL_TURNOVER                                            250
+#define _RTC3SIM_XTAL_COEFF_PPB                                           34
+
+#define _RTC3SIM_DMA_DESC_MAX                                             4
+
+#define _RTC3SIM_DMA_IDLE                                                 0
+#define _RTC3SIM_DMA_START                                                1
+#define _RTC3SIM_DMA_ADDRESS                                              2
+#define _RTC3SIM_DMA_DATA                                                 3
+#define _RTC3SIM_DMA_STOP                                                 4
+
+/* ---------------------------------------------------------------- VARIABLES */
+
+const uint8_t _RTC3SIM_I2C_ADDRESS                                       = 0x68;
+const uint8_t _RTC3SIM_SF_KEY1                                           = 0x5E;
+const uint8_t _RTC3SIM_SF_KEY2                                           = 0xC7;
+
+// Power-on register state ( 0x00 - 0x09 )
+static const uint8_t _resetState[ _RTC3SIM_REG_COUNT ] =
+{
+    0x00, 0x80, 0x00, 0x01, 0x01, 0x01, 0x00, 0x80, 0x00, 0x00
+};
+
+static uint8_t  _reg[ _RTC3SIM_REG_COUNT ]   = { 0x00, 0x80, 0x00, 0x01, 0x01, 0x01, 0x00, 0x80, 0x00, 0x00 };
+static uint8_t  _latch[ _RTC3SIM_REG_COUNT ];
+static uint8_t  _sfr;
+static uint8_t  _keyState;
+static uint8_t  _pointer;
+static uint8_t  _busState;
+static uint32_t _subSecondNs;
+static uint64_t _timeNs;
+
+// Crystal error, the divider chain adds the CONFIG1 calibration on top
+static int32_t  _crystalPpb;
+static int32_t  _driftPpb;
+static uint32_t _oscNs;
+static int64_t  _oscFrac;
+static int64_t  _chainFrac;
+
+// Wire time of one SCL clock and of one byte with its ACK clock
+static uint32_t _busBitNs;
+static uint32_t _busByteNs;
+static uint64_t _busTimeNs;
+
+// Interrupt driven I2C peripheral
+static rtc3sim_isr_t _i2cIsr;
+static uint8_t  _i2cOp;
+static uint8_t  _i2cData;
+static uint8_t  _i2cResult;
+static uint8_t  _i2cDone;
+static uint32_t _i2cRemainingNs;
+static uint32_t _i2cIrqCount;
+
+// DMA channel feeding the I2C peripheral
+static rtc3sim_dmaDesc_t _dmaDesc[ _RTC3SIM_DMA_DESC_MAX ];
+static uint8_t  _dmaDescCount;
+static uint8_t  _dmaDescIndex;
+static uint16_t _dmaByte;
+static uint8_t  _dmaAddress;
+static uint8_t  _dmaStage;
+static uint8_t  _dmaDone;
+static uint8_t  _dmaError;
+
+const T_rtc3sim_gpioObj _HOST_MIKROBUS_GPIO =
+{
+    { 0 },
+    { 0, 0, 0, 0, 0, 0, 0, rtc3sim_getIrq, 0, 0, 0, 0 }
+};
+
+const T_rtc3sim_i2cObj _HOST_MIKROBUS_I2C =
+{
+    rtc3sim_masterStart, rtc3sim_masterWrite, rtc3sim_masterRead
+};
+
+/* -------------------------------------------- PRIVATE FUNCTION DECLARATIONS */
+
+static uint8_t _bcdIncrement( uint8_t bcd );
+
+static uint8_t _daysInMonth( uint8_t monthBcd, uint8_t yearBcd );
+
+static void _countSecond();
+
+static uint8_t _readReg( uint8_t regAddress );
+
+static void _writeReg( uint8_t regAddress, uint8_t value );
+
+static int32_t _calibrationPpb();
+
+static uint32_t _scaleNs( uint32_t nanoseconds, int32_t ppb, int64_t *frac );
+
+static void _advanceClock( uint64_t nanoseconds );
+
+static void _i2cBegin( uint8_t op, uint8_t dataByte, uint32_t durationNs );
+
+static void _i2cComplete();
+
+static void _dmaData();
+
+static uint8_t _dmaStep();
+
+static void _masterWait( uint32_t durationNs );
+
+static void _masterEnd( uint8_t endMode );
+
+/* --------------------------------------------- PRIVATE FUNCTION DEFINITIONS */
+
+static uint8_t _bcdIncrement( uint8_t bcd )
+{
+    if ( ( bcd & 0x0F ) == 0x09 )
+    {
+        return ( bcd & 0xF0 ) + 0x10;
+    }
+
+    return bcd + 1;
+}
+
+static uint8_t _daysInMonth( uint8_t monthBcd, uint8_t yearBcd )
+{
+    static const uint8_t days[ 12 ] = { 0x31, 0x28, 0x31, 0x30, 0x31, 0x30, 0x31, 0x31, 0x30, 0x31, 0x30, 0x31 };
+    uint8_t month;
+    uint8_t year;
+
+    month = ( ( monthBcd >> 4 ) * 10 ) + ( monthBcd & 0x0F );
+    year = ( ( yearBcd >> 4 ) * 10 ) + ( yearBcd & 0x0F );
+
+    if ( ( month == 2 ) && ( ( year & 0x03 ) == 0 ) )
+    {
+        return 0x29;
+    }
+
+    return days[ ( month - 1 ) % 12 ];
+}
+
+static void _countSecond()
+{
+    if ( ( _reg[ 0 ] & 0x7F ) != 0x59 )
+    {
+        _reg[ 0 ] = _bcdIncrement( _reg[ 0 ] & 0x7F );
+        return;
+    }
+    _reg[ 0 ] = 0x00;
+
+    if ( ( _reg[ 1 ] & 0x7F ) != 0x59 )
+    {
+        _reg[ 1 ] = ( _reg[ 1 ] & 0x80 ) | _bcdIncrement( _reg[ 1 ] & 0x7F );
+        return;
+    }
+    _reg[ 1 ] &= 0x80;
+
+    if ( ( _reg[ 2 ] & 0x3F ) != 0x23 )
+    {
+        _reg[ 2 ] = ( _reg[ 2 ] & 0xC0 ) | _bcdIncrement( _reg[ 2 ] & 0x3F );
+        return;
+    }
+    _reg[ 2 ] &= 0xC0;
+
+    _reg[ 3 ] = ( ( _reg[ 3 ] & 0x07 ) >= 7 ) ? 1 : ( _reg[ 3 ] & 0x07 ) + 1;
+
+    if ( ( _reg[ 4 ] & 0x3F ) < _daysInMonth( _reg[ 5 ] & 0x1F, _reg[ 6 ] ) )
+    {
+        _reg[ 4 ] = _bcdIncrement( _reg[ 4 ] & 0x3F );
+        return;
+    }
+    _reg[ 4 ] = 0x01;
+
+    if ( ( _reg[ 5 ] & 0x1F ) != 0x12 )
+    {
+        _reg[ 5 ] = _bcdIncrement( _reg[ 5 ] & 0x1F );
+        return;
+    }
+    _reg[ 5 ] = 0x01;
+
+    if ( _reg[ 6 ] != 0x99 )
+    {
+        _reg[ 6 ] = _bcdIncrement( _reg[ 6 ] );
+        return;
+    }
+    _reg[ 6 ] = 0x00;
+
+    // CENT toggles on every century when CENT_EN is set
+    if ( _reg[ 2 ] & 0x80 )
+    {
+        _reg[ 2 ] ^= 0x40;
+    }
+}
+
+static uint8_t _readReg( uint8_t regAddress )
+{
+    if ( regAddress < _RTC3SIM_REG_COUNT )
+    {
+        return _latch[ regAddress ];
+    }
+
+    if ( regAddress == 0x22 )
+    {
+        return _sfr;
+    }
+
+    // SF KEY registers and unimplemented addresses read as 0x00
+    return 0x00;
+}
+
+static void _writeReg( uint8_t regAddress, uint8_t value )
+{
+    if ( regAddress == 0x20 )
+    {
+        _keyState = ( value == _RTC3SIM_SF_KEY1 ) ? 1 : 0;
+        return;
+    }
+
+    if ( regAddress == 0x21 )
+    {
+        _keyState = ( ( _keyState == 1 ) && ( value == _RTC3SIM_SF_KEY2 ) ) ? 2 : 0;
+        return;
+    }
+
+    if ( regAddress == 0x22 )
+    {
+        if ( _keyState == 2 )
+        {
+            _sfr = value & 0x01;
+        }
+        _keyState = 0;
+        return;
+    }
+
+    _keyState = 0;
+
+    if ( regAddress < _RTC3SIM_REG_COUNT )
+    {
+        _reg[ regAddress ] = value;
+        _latch[ regAddress ] = value;
+
+        // Seconds write restarts the countdown chain
+        if ( regAddress == 0x00 )
+        {
+            _subSecondNs = 0;
+        }
+    }
+}
+
+static int32_t _calibrationPpb()
+{
+    int32_t cal;
+
+    cal = _reg[ 7 ] & 0x1F;
+
+    // S set: negative, CAL / 245760, S clear: positive, CAL / 491520
+    if ( _reg[ 7 ] & 0x20 )
+    {
+        return -( int32_t )( ( cal * 1000000000LL ) / 245760 );
+    }
+
+    return ( int32_t )( ( cal * 1000000000LL ) / 491520 );
+}
+
+static uint32_t _scaleNs( uint32_t nanoseconds, int32_t ppb, int64_t *frac )
+{
+    int64_t delta;
+
+    // Carry the sub-nanosecond remainder so no error builds up over long runs
+    *frac += ( int64_t )nanoseconds * ppb;
+    delta = *frac / ( int64_t )_RTC3SIM_NS_PER_SECOND;
+    *frac -= delta * ( int64_t )_RTC3SIM_NS_PER_SECOND;
+
+    return ( uint32_t )( ( int64_t )nanoseconds + delta );
+}
+
+static void _advanceClock( uint64_t nanoseconds )
+{
+    uint32_t step;
+
+    _timeNs += nanoseconds;
+
+    while ( nanoseconds != 0 )
+    {
+        step = ( nanoseconds > _RTC3SIM_NS_PER_SECOND ) ? _RTC3SIM_NS_PER_SECOND : ( uint32_t )nanoseconds;
+        nanoseconds -= step;
+
+        // Oscillator phase, the 512 Hz output does not include the calibration
+        _oscNs = ( _oscNs + _scaleNs( step, _crystalPpb + _driftPpb, &_oscFrac ) ) % _RTC3SIM_NS_PER_SECOND;
+
+        // STOP bit holds the whole countdown chain
+        if ( _reg[ 0 ] & 0x80 )
+        {
+            continue;
+        }
+
+        _subSecondNs += _scaleNs( step, _crystalPpb + _driftPpb + _calibrationPpb(), &_chainFrac );
+
+        while ( _subSecondNs >= _RTC3SIM_NS_PER_SECOND )
+        {
+            _subSecondNs -= _RTC3SIM_NS_PER_SECOND;
+            _countSecond();
+        }
+    }
+}
+
+static void _i2cBegin( uint8_t op, uint8_t dataByte, uint32_t durationNs )
+{
+    _busTimeNs += durationNs;
+
+    _i2cOp = op;
+    _i2cData = dataByte;
+    _i2cDone = 0;
+    _i2cRemainingNs = durationNs;
+}
+
+static void _i2cComplete()
+{
+    uint8_t op;
+
+    op = _i2cOp;
+    _i2cOp = _RTC3SIM_I2C_OP_NONE;
+
+    // The bus sees the operation when the peripheral finishes it
+    switch ( op )
+    {
+        case _RTC3SIM_I2C_OP_START :
+            rtc3sim_busStart();
+            break;
+
+        case _RTC3SIM_I2C_OP_WRITE :
+            _i2cResult = rtc3sim_busWrite( _i2cData );
+            break;
+
+        case _RTC3SIM_I2C_OP_READ :
+            _i2cResult = rtc3sim_busRead( _i2cData );
+            break;
+
+        default :
+            rtc3sim_busStop();
+            break;
+    }
+
+    // Under DMA the CPU sees only the end of the whole transfer
+    if ( ( _dmaStage != _RTC3SIM_DMA_IDLE ) && ( _dmaStep() == 0 ) )
+    {
+        return;
+    }
+
+    _i2cDone = 1;
+    _i2cIrqCount++;
+
+    if ( _i2cIsr != 0 )
+    {
+        _i2cIsr();
+    }
+}
+
+static void _dmaData()
+{
+    rtc3sim_dmaDesc_t *desc;
+
+    desc = &_dmaDesc[ _dmaDescIndex ];
+
+    if ( _dmaByte < desc->nBytes )
+    {
+        _dmaStage = _RTC3SIM_DMA_DATA;
+
+        if ( desc->read )
+        {
+            _i2cBegin( _RTC3SIM_I2C_OP_READ, _dmaByte + 1 < desc->nBytes, _busByteNs );
+        }
+        else
+        {
+            _i2cBegin( _RTC3SIM_I2C_OP_WRITE, desc->pBuf[ _dmaByte++ ], _busByteNs );
+        }
+        return;
+    }
+
+    // Segment done, repeated START for the next one or STOP
+    if ( ++_dmaDescIndex < _dmaDescCount )
+    {
+        _dmaStage = _RTC3SIM_DMA_START;
+        _i2cBegin( _RTC3SIM_I2C_OP_START, 0, _busBitNs );
+    }
+    else
+    {
+        _dmaStage = _RTC3SIM_DMA_STOP;
+        _i2cBegin( _RTC3SIM_I2C_OP_STOP, 0, _busBitNs );
+    }
+}
+
+static uint8_t _dmaStep()
+{
+    rtc3sim_dmaDesc_t *desc;
+
+    desc = &_dmaDesc[ _dmaDescIndex ];
+
+    switch ( _dmaStage )
+    {
+        case _RTC3SIM_DMA_START :
+            _dmaStage = _RTC3SIM_DMA_ADDRESS;
+            _i2cBegin( _RTC3SIM_I2C_OP_WRITE, ( _dmaAddress << 1 ) | ( desc->read ? 0x01 : 0x00 ), _busByteNs );
+            return 0;
+
+        case _RTC3SIM_DMA_ADDRESS :
+            if ( _i2cResult == 0 )
+            {
+                break;
+            }
+            _dmaByte = 0;
+            _dmaData();
+            return 0;
+
+        case _RTC3SIM_DMA_DATA :
+            if ( desc->read )
+            {
+                desc->pBuf[ _dmaByte++ ] = _i2cResult;
+            }
+            else if ( _i2cResult == 0 )
+            {
+                break;
+            }
+            _dmaData();
+            return 0;
+
+        default :
+            _dmaStage = _RTC3SIM_DMA_IDLE;
+            _dmaDone = 1;
+            return 1;
+    }
+
+    // NACK, abort the transfer
+    _dmaError = 1;
+    _dmaStage = _RTC3SIM_DMA_STOP;
+    _i2cBegin( _RTC3SIM_I2C_OP_STOP, 0, _busBitNs );
+
+    return 0;
+}
+
+// The blocking master spins for the wire time of every bus condition and byte
+static void _masterWait( uint32_t durationNs )
+{
+    _busTimeNs += durationNs;
+
+    rtc3sim_advance( durationNs );
+}
+
+static void _masterEnd( uint8_t endMode )
+{
+    if ( endMode != 0 )
+    {
+        rtc3sim_busStop();
+    }
+    else
+    {
+        rtc3sim_busStart();
+    }
+
+    _masterWait( _busBitNs );
+}
+
+/* --------------------------------------------------------- PUBLIC FUNCTIONS */
+
+void rtc3sim_reset()
+{
+    uint8_t cnt;
+
+    for ( cnt = 0; cnt < _RTC3SIM_REG_COUNT; cnt++ )
+    {
+        _reg[ cnt ] = _resetState[ cnt ];
+        _latch[ cnt ] = _resetState[ cnt ];
+    }
+
+    _sfr = 0x00;
+    _keyState = 0;
+    _pointer = 0x00;
+    _busState = _RTC3SIM_BUS_IDLE;
+    _subSecondNs = 0;
+    _timeNs = 0;
+    _crystalPpb = 0;
+    _driftPpb = 0;
+    _oscNs = 0;
+    _oscFrac = 0;
+    _chainFrac = 0;
+
+    rtc3sim_setBusTiming( _RTC3SIM_SCL_HZ, _RTC3SIM_STRETCH_NS );
+    _busTimeNs = 0;
+
+    _i2cOp = _RTC3SIM_I2C_OP_NONE;
+    _i2cDone = 1;
+    _i2cResult = 0;
+    _i2cIrqCount = 0;
+
+    _dmaStage = _RTC3SIM_DMA_IDLE;
+    _dmaDone = 1;
+    _dmaError = 0;
+}
+
+void rtc3sim_advance( uint64_t nanoseconds )
+{
+    // Split the step at every peripheral completion, the handler may start the next one
+    while ( ( _i2cOp != _RTC3SIM_I2C_OP_NONE ) && ( nanoseconds >= _i2cRemainingNs ) )
+    {
+        nanoseconds -= _i2cRemainingNs;
+        _advanceClock( _i2cRemainingNs );
+        _i2cComplete();
+    }
+
+    if ( _i2cOp != _RTC3SIM_I2C_OP_NONE )
+    {
+        _i2cRemainingNs -= ( uint32_t )nanoseconds;
+    }
+
+    _advanceClock( nanoseconds );
+}
+
+uint64_t rtc3sim_getTime()
+{
+    return _timeNs;
+}
+
+void rtc3sim_setBusTiming( uint32_t sclHz, uint32_t stretchNs )
+{
+    _busBitNs = ( _RTC3SIM_NS_PER_SECOND + sclHz / 2 ) / sclHz;
+    _busByteNs = 9 * _busBitNs + stretchNs;
+}
+
+uint64_t rtc3sim_getBusTime()
+{
+    return _busTimeNs;
+}
+
+void rtc3sim_setCrystalError( int32_t ppb )
+{
+    _crystalPpb = ppb;
+}
+
+void rtc3sim_setTemperature( int16_t temperature )
+{
+    int32_t delta;
+
+    delta = ( int32_t )temperature - _RTC3SIM_XTAL_TURNOVER;
+
+    // Temperature is in 0.1 C, so the square is in 0.01 C^2
+    _driftPpb = -( delta * delta * _RTC3SIM_XTAL_COEFF_PPB ) / 100;
+}
+
+void rtc3sim_failOscillator()
+{
+    _reg[ 1 ] |= 0x80;
+}
+
+uint8_t rtc3sim_peek( uint8_t regAddress )
+{
+    if ( regAddress < _RTC3SIM_REG_COUNT )
+    {
+        return _reg[ regAddress ];
+    }
+
+    if ( regAddress == 0x22 )
+    {
+        return _sfr;
+    }
+
+    return 0x00;
+}
+
+void rtc3sim_poke( uint8_t regAddress, uint8_t value )
+{
+    if ( regAddress < _RTC3SIM_REG_COUNT )
+    {
+        _reg[ regAddress ] = value;
+    }
+
+    if ( regAddress == 0x22 )
+    {
+        _sfr = value & 0x01;
+    }
+}
+
+uint8_t rtc3sim_getIrq()
+{
+    uint32_t phase;
+
+    // FT clear: IRQ follows the OUT bit
+    if ( ( _reg[ 7 ] & 0x40 ) == 0 )
+    {
+        return ( _reg[ 7 ] & 0x80 ) ? 1 : 0;
+    }
+
+    // FTF set: 1 Hz, high for the first half of every second
+    if ( _sfr & 0x01 )
+    {
+        return ( _subSecondNs < ( _RTC3SIM_NS_PER_SECOND / 2 ) ) ? 1 : 0;
+    }
+
+    // FTF clear: 512 Hz from the uncalibrated oscillator, high for the first half of every period
+    phase = ( uint32_t )( ( ( uint64_t )_oscNs * 1024 ) / _RTC3SIM_NS_PER_SECOND );
+
+    return ( phase & 0x01 ) ? 0 : 1;
+}
+
+int rtc3sim_masterStart()
+{
+    rtc3sim_busStart();
+    _masterWait( _busBitNs );
+
+    return 0;
+}
+
+int rtc3sim_masterWrite( uint8_t slaveAddress, uint8_t *pBuf, uint16_t nBytes, uint8_t endMode )
+{
+    uint16_t cnt;
+
+    _masterWait( _busByteNs );
+
+    if ( rtc3sim_busWrite( slaveAddress << 1 ) == 0 )
+    {
+        rtc3sim_busStop();
+        _masterWait( _busBitNs );
+        return 1;
+    }
+
+    for ( cnt = 0; cnt < nBytes; cnt++ )
+    {
+        _masterWait( _busByteNs );
+
+        if ( rtc3sim_busWrite( pBuf[ cnt ] ) == 0 )
+        {
+            rtc3sim_busStop();
+            _masterWait( _busBitNs );
+            return 1;
+        }
+    }
+
+    _masterEnd( endMode );
+
+    return 0;
+}
+
+int rtc3sim_masterRead( uint8_t slaveAddress, uint8_t *pBuf, uint16_t nBytes, uint8_t endMode )
+{
+    uint16_t cnt;
+
+    _masterWait( _busByteNs );
+
+    if ( rtc3sim_busWrite( ( slaveAddress << 1 ) | 0x01 ) == 0 )
+    {
+        rtc3sim_busStop();
+        _masterWait( _busBitNs );
+        return 1;
+    }
+
+    // Master ACKs every byte except the last one
+    for ( cnt = 0; cnt < nBytes; cnt++ )
+    {
+        _masterWait( _busByteNs );
+        pBuf[ cnt ] = rtc3sim_busRead( cnt + 1 < nBytes );
+    }
+
+    _masterEnd( endMode );
+
+    return 0;
+}
+
+#ifdef __linux__
+int rtc3sim_i2cdevIoctl( int fd, unsigned long request, void *arg )
+{
+    struct i2c_rdwr_ioctl_data *rdwr;
+    struct i2c_msg *msg;
+    uint8_t endMode;
+    uint32_t cnt;
+    int err;
+
+    ( void )fd;
+
+    if ( request != I2C_RDWR )
+    {
+        return -1;
+    }
+
+    rdwr = ( struct i2c_rdwr_ioctl_data * )arg;
+
+    rtc3sim_masterStart();
+
+    for ( cnt = 0; cnt < rdwr->nmsgs; cnt++ )
+    {
+        msg = &rdwr->msgs[ cnt ];
+
+        // Messages are joined by repeated STARTs, the last one ends with a STOP
+        endMode = ( cnt + 1 == rdwr->nmsgs ) ? 1 : 0;
+
+        if ( msg->flags & I2C_M_RD )
+        {
+            err = rtc3sim_masterRead( ( uint8_t )msg->addr, msg->buf, msg->len, endMode );
+        }
+        else
+        {
+            err = rtc3sim_masterWrite( ( uint8_t )msg->addr, msg->buf, msg->len, endMode );
+        }
+
+        if ( err != 0 )
+        {
+            return -1;
+        }
+    }
+
+    return ( int )rdwr->nmsgs;
+}
+#endif
+
+void rtc3sim_busStart()
+{
+    uint8_t cnt;
+
+    // Time registers are latched on a START from an idle bus only
+    if ( _busState == _RTC3SIM_BUS_IDLE )
+    {
+        for ( cnt = 0; cnt < _RTC3SIM_REG_COUNT; cnt++ )
+        {
+            _latch[ cnt ] = _reg[ cnt ];
+        }
+    }
+
+    _busState = _RTC3SIM_BUS_ADDRESS;
+}
+
+uint8_t rtc3sim_busWrite( uint8_t dataByte )
+{
+    switch ( _busState )
+    {
+        case _RTC3SIM_BUS_ADDRESS :
+            if ( ( dataByte >> 1 ) != _RTC3SIM_I2C_ADDRESS )
+            {
+                _busState = _RTC3SIM_BUS_IGNORE;
+                return 0;
+            }
+            _busState = ( dataByte & 0x01 ) ? _RTC3SIM_BUS_READ : _RTC3SIM_BUS_POINTER;
+            return 1;
+
+        case _RTC3SIM_BUS_POINTER :
+            _pointer = dataByte;
+            _busState = _RTC3SIM_BUS_WRITE;
+            return 1;
+
+        case _RTC3SIM_BUS_WRITE :
+            _writeReg( _pointer, dataByte );
+            _pointer++;
+            return 1;
+
+        default :
+            return 0;
+    }
+}
+
+uint8_t rtc3sim_busRead( uint8_t ack )
+{
+    uint8_t value;
+
+    if ( _busState != _RTC3SIM_BUS_READ )
+    {
+        return 0xFF;
+    }
+
+    value = _readReg( _pointer );
+    _pointer++;
+
+    // After a NACK the slave releases the bus until the next START
+    if ( ack == 0 )
+    {
+        _busState = _RTC3SIM_BUS_IGNORE;
+    }
+
+    return value;
+}
+
+void rtc3sim_busStop()
+{
+    _busState = _RTC3SIM_BUS_IDLE;
+}
+
+void rtc3sim_i2cIrqMap( rtc3sim_isr_t isr )
+{
+    _i2cIsr = isr;
+}
+
+void rtc3sim_i2cStart()
+{
+    _i2cBegin( _RTC3SIM_I2C_OP_START, 0, _busBitNs );
+}
+
+void rtc3sim_i2cWrite( uint8_t dataByte )
+{
+    _i2cBegin( _RTC3SIM_I2C_OP_WRITE, dataByte, _busByteNs );
+}
+
+void rtc3sim_i2cRead( uint8_t ack )
+{
+    _i2cBegin( _RTC3SIM_I2C_OP_READ, ack, _busByteNs );
+}
+
+void rtc3sim_i2cStop()
+{
+    _i2cBegin( _RTC3SIM_I2C_OP_STOP, 0, _busBitNs );
+}
+
+uint8_t rtc3sim_i2cDone()
+{
+    return _i2cDone;
+}
+
+uint8_t rtc3sim_i2cResult()
+{
+    return _i2cResult;
+}
+
+uint32_t rtc3sim_i2cIrqCount()
+{
+    return _i2cIrqCount;
+}
+
+uint8_t rtc3sim_dmaStart( uint8_t slaveAddress, const rtc3sim_dmaDesc_t *desc, uint8_t nDesc )
+{
+    uint8_t cnt;
+
+    if ( ( _dmaStage != _RTC3SIM_DMA_IDLE ) || ( _i2cOp != _RTC3SIM_I2C_OP_NONE ) )
+    {
+        return 1;
+    }
+
+    if ( ( nDesc == 0 ) || ( nDesc > _RTC3SIM_DMA_DESC_MAX ) )
+    {
+        return 1;
+    }
+
+    for ( cnt = 0; cnt < nDesc; cnt++ )
+    {
+        _dmaDesc[ cnt ] = desc[ cnt ];
+    }
+
+    _dmaDescCount = nDesc;
+    _dmaDescIndex = 0;
+    _dmaAddress = slaveAddress;
+    _dmaDone = 0;
+    _dmaError = 0;
+    _dmaStage = _RTC3SIM_DMA_START;
+
+    _i2cBegin( _RTC3SIM_I2C_OP_START, 0, _busBitNs );
+
+    return 0;
+}
+
+uint8_t rtc3sim_dmaDone()
+{
+    return _dmaDone;
+}
+
+uint8_t rtc3sim_dmaError()
+{
+    return _dmaError;
+}
+
+/* -------------------------------------------------------------------------- */
+/*
+  __rtc3_sim.c
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+3. All advertising materials mentioning features or use of this software
+   must display the following acknowledgement:
+   This product includes software developed by the MikroElektonika.
+
+4. Neither the name of the MikroElektonika nor the
+   names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY MIKROELEKTRONIKA ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL MIKROELEKTRONIKA BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------------- */
@@ -0,0 +1,450 @@
+/*
+    __rtc3_sim.h
+
+-----------------------------------------------------------------------------
+
+  This file is part of mikroSDK.
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+----------------------------------------------------------------------------- */
+
+/**
+@file   __rtc3_sim.h
+@brief    BQ32000 Host Simulator
+*/
+/**
+@defgroup   RTC3_SIM
+@brief      BQ32000 register-level model used by the host ( Linux/gcc ) HAL
+@{
+
+The model implements the BQ32000 register file ( 0x00 - 0x09 ), the special
+function key registers ( 0x20, 0x21 ) and the special function register
+( 0x22 ) behind a byte-level I2C bus interface. It keeps its own notion of
+time, which only moves when rtc3sim_advance is called, so every run is
+deterministic.
+
+Modelled behaviour :
+
+- Clock and calendar counting in BCD, including month lengths, leap years
+  and the CENT bit when CENT_EN is set.
+- STOP bit ( 0x00 bit 7 ) halts counting, OF bit ( 0x01 bit 7 ) is set by
+  rtc3sim_failOscillator and cleared by writing 0 to it.
+- Writing the seconds register restarts the sub-second countdown chain.
+- Time registers are latched on a START condition from an idle bus, so a
+  burst read is always coherent.
+- Register pointer auto-increments after every data byte.
+- SFR writes are accepted only right after SF KEY 1 ( 0x5E ) and
+  SF KEY 2 ( 0xC7 ) have been written in order.
+- IRQ pin follows OUT, or the 512 Hz / 1 Hz calibration output when FT is set.
+- A crystal error ( rtc3sim_setCrystalError ) skews the oscillator. The CAL
+  bits correct the divider chain and the 1 Hz output, not the 512 Hz one.
+- The crystal drifts parabolically with temperature ( rtc3sim_setTemperature ).
+- A bus master ( rtc3sim_master* ) with the calling convention of the
+  compiler I2C library, reachable through the _HOST_MIKROBUS_I2C object.
+  It blocks for the wire time of every condition and byte, so simulated
+  time moves by the bus latency of each driver call.
+- Wire time is one SCL clock per START, repeated START and STOP and nine
+  per byte with its ACK / NACK, plus an optional clock stretch by the
+  slave after every byte ( rtc3sim_setBusTiming, 100 kHz by default ).
+- An interrupt driven I2C peripheral ( rtc3sim_i2c* ) runs one bus
+  operation at a time with the same timing and signals its completion
+  through an emulated interrupt handler as simulated time passes.
+- A DMA channel ( rtc3sim_dma* ) walks a list of descriptors, one per
+  segment between repeated STARTs, through the same peripheral without
+  any handler calls, and raises the interrupt once at the end.
+
+Build the driver for the host with __HAL_HOST__ defined and link this model:
+
+    gcc -D__HAL_HOST__ -Ilibrary app.c library/__rtc3_driver.c library/__rtc3_sim.c
+
+*/
+/* -------------------------------------------------------------------------- */
+
+#include "stdint.h"
+
+#ifndef _RTC3_SIM_H_
+#define _RTC3_SIM_H_
+
+/** @defgroup RTC3_SIM_VAR Variables */                       /** @{ */
+
+extern const uint8_t _RTC3SIM_I2C_ADDRESS;
+extern const uint8_t _RTC3SIM_SF_KEY1;
+extern const uint8_t _RTC3SIM_SF_KEY2;
+
+                                                                       /** @} */
+/** @defgroup RTC3_SIM_TYPES Types */                         /** @{ */
+
+/**
+ * @brief Host mikroBUS GPIO object
+ *
+ * Same layout as the HAL GPIO object, INT pin ( index 7 ) reads the
+ * simulated IRQ output.
+ */
+typedef struct
+{
+    void    (*gpioSet[ 12 ])(uint8_t);
+    uint8_t (*gpioGet[ 12 ])();
+
+}T_rtc3sim_gpioObj;
+
+/**
+ * @brief Host mikroBUS I2C object
+ *
+ * Same layout as the host HAL I2C object, the bus master functions
+ * play the role of the compiler's I2C library.
+ */
+typedef struct
+{
+    int     (*i2cStart)();
+    int     (*i2cWrite)(uint8_t, uint8_t*, uint16_t, uint8_t);
+    int     (*i2cRead)(uint8_t, uint8_t*, uint16_t, uint8_t);
+
+}T_rtc3sim_i2cObj;
+
+/**
+ * @brief Peripheral interrupt handler
+ */
+typedef void (*rtc3sim_isr_t)();
+
+/**
+ * @brief DMA descriptor
+ *
+ * One transfer segment, segments are joined by repeated STARTs.
+ */
+typedef struct
+{
+    uint8_t     *pBuf;                      /**< Memory side buffer */
+    uint16_t    nBytes;                     /**< Bytes to move */
+    uint8_t     read;                       /**< 1 - slave to memory, 0 - memory to slave */
+
+}rtc3sim_dmaDesc_t;
+
+                                                                       /** @} */
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/** @defgroup RTC3_SIM_OBJ Host mikroBUS objects */           /** @{ */
+
+extern const T_rtc3sim_gpioObj _HOST_MIKROBUS_GPIO;
+extern const T_rtc3sim_i2cObj  _HOST_MIKROBUS_I2C;
+
+                                                                       /** @} */
+/** @defgroup RTC3_SIM_FUNC Simulator Functions */            /** @{ */
+
+/**
+ * @brief Reset simulator function
+ *
+ * Function puts the model into its power-on state: time 00:00:00,
+ * 01.01.00, Monday, OF set, counting enabled, CONFIG1 = 0x80.
+ */
+void rtc3sim_reset();
+
+/**
+ * @brief Advance simulated time function
+ *
+ * @param[in] nanoseconds          Time to advance the model by
+ *
+ * Function advances the oscillator and, when counting is enabled,
+ * the clock and calendar registers.
+ */
+void rtc3sim_advance( uint64_t nanoseconds );
+
+/**
+ * @brief Get simulated time function
+ *
+ * @return Nanoseconds elapsed since the last rtc3sim_reset
+ */
+uint64_t rtc3sim_getTime();
+
+/**
+ * @brief Set bus timing function
+ *
+ * @param[in] sclHz                SCL frequency, 100000 standard mode or
+ *                                 400000 fast mode
+ * @param[in] stretchNs            Time the slave holds SCL low after every
+ *                                 byte, 0 for no clock stretching
+ *
+ * Timing applies to the blocking bus master and to the I2C peripheral.
+ * rtc3sim_reset returns to 100 kHz without stretching.
+ */
+void rtc3sim_setBusTiming( uint32_t sclHz, uint32_t stretchNs );
+
+/**
+ * @brief Get bus time function
+ *
+ * @return Nanoseconds of wire time since the last rtc3sim_reset
+ */
+uint64_t rtc3sim_getBusTime();
+
+/**
+ * @brief i2c-dev ioctl function
+ *
+ * @param[in] fd                   Adapter file descriptor, not used
+ * @param[in] request              ioctl request, only I2C_RDWR is served
+ * @param[in] arg                  pointer of struct i2c_rdwr_ioctl_data
+ *
+ * @return Number of messages transferred, -1 on a NACK or another request
+ *
+ * Function runs the messages through the bus master as one transaction,
+ * joined by repeated STARTs, in place of the Linux i2c-dev driver.
+ */
+#ifdef __linux__
+int rtc3sim_i2cdevIoctl( int fd, unsigned long request, void *arg );
+#endif
+
+/**
+ * @brief Set crystal error function
+ *
+ * @param[in] ppb                  Crystal frequency error in parts per
+ *                                 billion, positive runs fast
+ *
+ * The error applies to the oscillator and so to the 512 Hz output.
+ * The divider chain, the clock registers and the 1 Hz output also
+ * follow the CAL bits of CONFIG1. rtc3sim_reset clears the error.
+ */
+void rtc3sim_setCrystalError( int32_t ppb );
+
+/**
+ * @brief Set crystal temperature function
+ *
+ * @param[in] temperature          Crystal temperature in 0.1 degrees C
+ *
+ * Function adds the parabolic drift of a tuning fork crystal,
+ * -0.034 ppm / C^2 around a 25.0 C turnover, on top of the error set by
+ * rtc3sim_setCrystalError. rtc3sim_reset returns to 25.0 C.
+ */
+void rtc3sim_setTemperature( int16_t temperature );
+
+/**
+ * @brief Force oscillator fail function
+ *
+ * Function sets the OF flag as the chip does after an oscillator stop.
+ */
+void rtc3sim_failOscillator();
+
+/**
+ * @brief Peek register function
+ *
+ * @param[in] regAddress           Register address
+ *
+ * @return Live register value, without any bus traffic
+ */
+uint8_t rtc3sim_peek( uint8_t regAddress );
+
+/**
+ * @brief Poke register function
+ *
+ * @param[in] regAddress           Register address
+ * @param[in] value                Value to store, without any bus traffic
+ */
+void rtc3sim_poke( uint8_t regAddress, uint8_t value );
+
+/**
+ * @brief Get IRQ pin state function
+ *
+ * @return Level of the simulated IRQ open-drain output ( 1 - released )
+ */
+uint8_t rtc3sim_getIrq();
+
+/**
+ * @brief Master START function
+ *
+ * @return 0
+ */
+int rtc3sim_masterStart();
+
+/**
+ * @brief Master write function
+ *
+ * @param[in] slaveAddress         7 bit slave address
+ * @param[in] pBuf                 pointer to data buffer
+ * @param[in] nBytes               number of bytes to write
+ * @param[in] endMode              0 - repeated START, 1 - STOP
+ *
+ * @return 0 - ACKed, 1 - NACK, the transfer is stopped
+ */
+int rtc3sim_masterWrite( uint8_t slaveAddress, uint8_t *pBuf, uint16_t nBytes, uint8_t endMode );
+
+/**
+ * @brief Master read function
+ *
+ * @param[in] slaveAddress         7 bit slave address
+ * @param[out] pBuf                pointer to data buffer
+ * @param[in] nBytes               number of bytes to read
+ * @param[in] endMode              0 - repeated START, 1 - STOP
+ *
+ * @return 0 - address ACKed, 1 - NACK, the transfer is stopped
+ */
+int rtc3sim_masterRead( uint8_t slaveAddress, uint8_t *pBuf, uint16_t nBytes, uint8_t endMode );
+
+/**
+ * @brief Bus START function
+ *
+ * Function signals a START, or a repeated START when a transfer is active.
+ */
+void rtc3sim_busStart();
+
+/**
+ * @brief Bus write byte function
+ *
+ * @param[in] dataByte             Address or data byte written by the master
+ *
+ * @return 1 - ACK, 0 - NACK
+ */
+uint8_t rtc3sim_busWrite( uint8_t dataByte );
+
+/**
+ * @brief Bus read byte function
+ *
+ * @param[in] ack                  1 - master ACKs the byte, 0 - NACK
+ *
+ * @return Byte driven by the slave
+ */
+uint8_t rtc3sim_busRead( uint8_t ack );
+
+/**
+ * @brief Bus STOP function
+ */
+void rtc3sim_busStop();
+
+/**
+ * @brief Map peripheral interrupt handler function
+ *
+ * @param[in] isr                  Handler called on every completed
+ *                                 operation, 0 - completion is polled only
+ *
+ * The handler runs from inside rtc3sim_advance and may start the next
+ * operation.
+ */
+void rtc3sim_i2cIrqMap( rtc3sim_isr_t isr );
+
+/**
+ * @brief Peripheral START function
+ *
+ * Function begins a START, or a repeated START, which completes after
+ * one bit time.
+ */
+void rtc3sim_i2cStart();
+
+/**
+ * @brief Peripheral write byte function
+ *
+ * @param[in] dataByte             Address or data byte
+ *
+ * Function begins a byte write, which completes after nine bit times.
+ */
+void rtc3sim_i2cWrite( uint8_t dataByte );
+
+/**
+ * @brief Peripheral read byte function
+ *
+ * @param[in] ack                  1 - ACK the byte, 0 - NACK
+ *
+ * Function begins a byte read, which completes after nine bit times.
+ */
+void rtc3sim_i2cRead( uint8_t ack );
+
+/**
+ * @brief Peripheral STOP function
+ *
+ * Function begins a STOP, which completes after one bit time.
+ */
+void rtc3sim_i2cStop();
+
+/**
+ * @brief Peripheral done function
+ *
+ * @return 1 - last operation completed, 0 - in progress
+ */
+uint8_t rtc3sim_i2cDone();
+
+/**
+ * @brief Peripheral result function
+ *
+ * @return ACK of the last byte write ( 1 - ACK ), or the last byte read
+ */
+uint8_t rtc3sim_i2cResult();
+
+/**
+ * @brief Peripheral interrupt count function
+ *
+ * @return Completion interrupts raised since the last rtc3sim_reset
+ */
+uint32_t rtc3sim_i2cIrqCount();
+
+/**
+ * @brief DMA start function
+ *
+ * @param[in] slaveAddress         7 bit slave address
+ * @param[in] desc                 Descriptor list, copied before return
+ * @param[in] nDesc                Number of descriptors [ 1 - 4 ]
+ *
+ * @return 0 - transfer queued, 1 - channel or peripheral busy
+ *
+ * Function queues a complete START ... STOP transaction. Buffers must
+ * stay valid until rtc3sim_dmaDone returns 1.
+ */
+uint8_t rtc3sim_dmaStart( uint8_t slaveAddress, const rtc3sim_dmaDesc_t *desc, uint8_t nDesc );
+
+/**
+ * @brief DMA done function
+ *
+ * @return 1 - last queued transfer finished
+ */
+uint8_t rtc3sim_dmaDone();
+
+/**
+ * @brief DMA error function
+ *
+ * @return 1 - last transfer was aborted on a NACK
+ */
+uint8_t rtc3sim_dmaError();
+
+                                                                       /** @} */
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif
+                                                                       /** @} */
+/* -------------------------------------------------------------------------- */
+/*
+  __rtc3_sim.h
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+3. All advertising materials mentioning features or use of this software
+   must display the following acknowledgement:
+   This product includes software developed by the MikroElektonika.
+
+4. Neither the name of the MikroElektonika nor the
+   names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY MIKROELEKTRONIKA ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL MIKROELEKTRONIKA BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------------- */
@@ -0,0 +1,480 @@
+/*
+    rtc3.hpp
+
+-----------------------------------------------------------------------------
+
+  This file is part of mikroSDK.
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+----------------------------------------------------------------------------- */
+
+/**
+@file   rtc3.hpp
+@brief    RTC_3 Header-only C++17 Driver
+*/
+/**
+@defgroup   RTC3_CPP
+@brief      Header-only C++17 driver for the BQ32000 chip on RTC 3 Click
+@{
+
+Registers and their bitfields are types, so every register address, mask
+and shift is a compile-time constant. The bus is a policy class, and every
+call on a stateless policy inlines down to the bus primitives.
+
+A bus policy provides the three calls of the mikroSDK I2C HAL:
+
+    struct MyBus
+    {
+        static void start();
+        static void write( uint8_t slave, uint8_t *pBuf, uint16_t nBytes, uint8_t endMode );
+        static void read( uint8_t slave, uint8_t *pBuf, uint16_t nBytes, uint8_t endMode );
+    };
+
+    rtc3::Device< MyBus > rtc;
+
+    rtc.init();
+    rtc.write< rtc3::CAL_S, rtc3::CAL >( 1, 5 );     // one CONFIG1 write
+    rtc.getDateTime( dateTime );                     // one burst read
+
+Every call puts the same transactions on the bus as the matching C
+function of __rtc3_driver.c, including the configuration shadow
+registers. Writing FTF writes the SF key sequence first.
+
+On the host, with __HAL_HOST__ defined, rtc3::SimBus drives the BQ32000
+simulator ( __rtc3_sim.c ).
+
+*/
+/* -------------------------------------------------------------------------- */
+
+#ifndef _RTC3_HPP_
+#define _RTC3_HPP_
+
+#include <stdint.h>
+#include <type_traits>
+
+#ifdef __HAL_HOST__
+#include "__rtc3_sim.h"
+#endif
+
+namespace rtc3
+{
+
+/** @defgroup RTC3_CPP_REG Registers and fields */            /** @{ */
+
+constexpr uint8_t I2C_ADDRESS   = 0x68;
+constexpr uint8_t SF_KEY1_VALUE = 0x5E;
+constexpr uint8_t SF_KEY2_VALUE = 0xC7;
+
+constexpr uint8_t END_MODE_RESTART = 0;
+constexpr uint8_t END_MODE_STOP    = 1;
+
+/**
+ * @brief Register type
+ *
+ * @tparam Address                  register address
+ * @tparam Shadowed                 register is write-only in practice and
+ *                                  kept in a shadow, as in the C driver
+ */
+template< uint8_t Address, bool Shadowed = false >
+struct Register
+{
+    static constexpr uint8_t address  = Address;
+    static constexpr bool    shadowed = Shadowed;
+};
+
+using REG_TIME_SEC      = Register< 0x00 >;
+using REG_TIME_MIN      = Register< 0x01 >;
+using REG_TIME_HOUR     = Register< 0x02 >;
+using REG_TIME_DAY      = Register< 0x03 >;
+using REG_DATE_DAY      = Register< 0x04 >;
+using REG_DATE_MONTH    = Register< 0x05 >;
+using REG_DATE_YEAR     = Register< 0x06 >;
+using REG_CONFIG1       = Register< 0x07, true >;
+using REG_TRICKLE_CHARGE2 = Register< 0x08, true >;
+using REG_CONFIG2       = Register< 0x09, true >;
+using REG_SF_KEY1       = Register< 0x20 >;
+using REG_SF_KEY2       = Register< 0x21 >;
+using REG_SFR           = Register< 0x22, true >;
+
+/**
+ * @brief Bitfield type
+ *
+ * @tparam Reg                      register holding the field
+ * @tparam Shift                    position of the lowest bit
+ * @tparam Width                    number of bits
+ */
+template< typename Reg, uint8_t Shift, uint8_t Width >
+struct Field
+{
+    using reg = Reg;
+
+    static constexpr uint8_t shift = Shift;
+    static constexpr uint8_t mask  = ( uint8_t )( ( ( 1u << Width ) - 1u ) << Shift );
+
+    static constexpr uint8_t get( uint8_t regValue )
+    {
+        return ( uint8_t )( ( regValue & mask ) >> shift );
+    }
+
+    static constexpr uint8_t set( uint8_t regValue, uint8_t fieldValue )
+    {
+        return ( uint8_t )( ( regValue & ~mask ) | ( ( fieldValue << shift ) & mask ) );
+    }
+};
+
+using STOP = Field< REG_TIME_SEC, 7, 1 >;         /**< Oscillator stop, 1 holds counting */
+using OF   = Field< REG_TIME_MIN, 7, 1 >;         /**< Oscillator fail flag */
+using OUT  = Field< REG_CONFIG1, 7, 1 >;          /**< IRQ pin level when FT is clear */
+using FT   = Field< REG_CONFIG1, 6, 1 >;          /**< Calibration output on the IRQ pin */
+using CAL_S = Field< REG_CONFIG1, 5, 1 >;         /**< Calibration sign, 1 negative */
+using CAL  = Field< REG_CONFIG1, 0, 5 >;          /**< Calibration steps */
+using TCH2 = Field< REG_TRICKLE_CHARGE2, 5, 1 >;  /**< Trickle charge switch 2 */
+using TCFE = Field< REG_CONFIG2, 5, 1 >;          /**< Trickle charge FET bypass */
+using FTF  = Field< REG_SFR, 0, 1 >;              /**< Calibration output 1 Hz instead of 512 Hz */
+
+static_assert( CAL::mask == 0x1F && CAL_S::mask == 0x20 && FT::mask == 0x40 && OUT::mask == 0x80, "CONFIG1 layout" );
+static_assert( CAL_S::set( CAL::set( 0xC0, 5 ), 1 ) == 0xE5, "field insert" );
+
+                                                                       /** @} */
+/** @defgroup RTC3_CPP_TYPES Types */                         /** @{ */
+
+/**
+ * @brief Date and time, same layout as rtc3_datetime_t
+ */
+struct DateTime
+{
+    uint8_t  timeSeconds;                   /**< Time seconds [ 0 sec - 59 sec ] */
+    uint8_t  timeMinutes;                   /**< Time minutes [ 0 min - 59 min ] */
+    uint8_t  timeHours;                     /**< Time hours [ 0 h - 23 h ] */
+    uint8_t  dayOfTheWeek;                  /**< Day of the week [ 1 - 7 ] */
+    uint8_t  dateDay;                       /**< Date day [ 1 - 31 ] */
+    uint8_t  dateMonth;                     /**< Date month [ 1 - 12 ] */
+    uint16_t dateYear;                      /**< Date year [ 0 - 99 ] */
+};
+
+                                                                       /** @} */
+/** @defgroup RTC3_CPP_BCD BCD conversion */                  /** @{ */
+
+constexpr uint8_t bcdDecode( uint8_t bcd )
+{
+    return ( uint8_t )( bcd - ( ( bcd >> 4 ) * 6 ) );
+}
+
+constexpr uint8_t bcdEncode( uint8_t value )
+{
+    return ( uint8_t )( ( ( value / 10 ) << 4 ) | ( value % 10 ) );
+}
+
+// Mirrors _fieldEncode of the C driver: wrap into range, then clamp to the minimum
+constexpr uint8_t fieldEncode( uint8_t value, uint8_t range, uint8_t minimum )
+{
+    return bcdEncode( ( uint8_t )( ( ( value % range ) < minimum ) ? minimum : ( value % range ) ) );
+}
+
+constexpr uint8_t yearEncode( uint16_t dateYear )
+{
+    return bcdEncode( ( uint8_t )( ( ( dateYear >= 2000 ) ? dateYear - 2000 : dateYear ) % 100 ) );
+}
+
+static_assert( bcdDecode( 0x59 ) == 59 && bcdEncode( 59 ) == 0x59, "BCD" );
+static_assert( fieldEncode( 0, 8, 1 ) == 0x01 && yearEncode( 2024 ) == 0x24, "field encode" );
+
+                                                                       /** @} */
+/** @defgroup RTC3_CPP_DEV Device */                          /** @{ */
+
+/**
+ * @brief BQ32000 device
+ *
+ * @tparam Bus                      bus policy
+ * @tparam Slave                    7-bit slave address
+ */
+template< typename Bus, uint8_t Slave = I2C_ADDRESS >
+class Device
+{
+public:
+
+    /**
+     * @brief Init function
+     *
+     * Function loads the configuration shadow registers from the chip.
+     */
+    void init()
+    {
+        uint8_t rBuffer[ 3 ] = { 0, 0, 0 };
+
+        readBlock< REG_CONFIG1 >( rBuffer, 3 );
+
+        shadowConfig1 = rBuffer[ 0 ];
+        shadowTrickleCharge2 = rBuffer[ 1 ];
+        shadowConfig2 = rBuffer[ 2 ];
+
+        readBlock< REG_SFR >( rBuffer, 1 );
+
+        shadowSfr = rBuffer[ 0 ];
+    }
+
+    /**
+     * @brief Burst read function
+     *
+     * @tparam Reg                   first register
+     * @param[out] pBuf              pointer of read data
+     * @param[in] nBytes             number of registers to read
+     */
+    template< typename Reg >
+    void readBlock( uint8_t *pBuf, uint8_t nBytes )
+    {
+        uint8_t wBuffer[ 1 ] = { Reg::address };
+
+        Bus::start();
+        Bus::write( Slave, wBuffer, 1, END_MODE_RESTART );
+        Bus::read( Slave, pBuf, nBytes, END_MODE_STOP );
+    }
+
+    /**
+     * @brief Burst write function
+     *
+     * @tparam Reg                   first register
+     * @tparam N                     number of registers to write
+     * @param[in] pBuf               data to write
+     */
+    template< typename Reg, uint8_t N >
+    void writeBlock( const uint8_t ( &pBuf )[ N ] )
+    {
+        uint8_t wBuffer[ N + 1 ];
+        uint8_t cnt;
+
+        static_assert( N >= 1 && N <= 10, "block size" );
+
+        wBuffer[ 0 ] = Reg::address;
+
+        for ( cnt = 0; cnt < N; cnt++ )
+        {
+            wBuffer[ cnt + 1 ] = pBuf[ cnt ];
+        }
+
+        Bus::start();
+        Bus::write( Slave, wBuffer, N + 1, END_MODE_STOP );
+
+        for ( cnt = 0; cnt < N; cnt++ )
+        {
+            shadowStore( Reg::address + cnt, pBuf[ cnt ] );
+        }
+    }
+
+    /**
+     * @brief Read field function
+     *
+     * @tparam F                     field
+     * @return Field value, from the shadow for configuration registers
+     */
+    template< typename F >
+    uint8_t read()
+    {
+        uint8_t value = 0;
+
+        if constexpr ( F::reg::shadowed )
+        {
+            value = shadowLoad( F::reg::address );
+        }
+        else
+        {
+            readBlock< typename F::reg >( &value, 1 );
+        }
+
+        return F::get( value );
+    }
+
+    /**
+     * @brief Write fields function
+     *
+     * @tparam F                     one or more fields of the same register
+     * @param[in] values             one value per field
+     *
+     * Function writes the register once. Configuration registers are
+     * modified in their shadow, other registers are read first.
+     * Writing FTF is preceded by the SF key sequence.
+     */
+    template< typename F, typename... More, typename... Values >
+    void write( Values... values )
+    {
+        using Reg = typename F::reg;
+
+        static_assert( sizeof...( More ) + 1 == sizeof...( Values ), "one value per field" );
+        static_assert( ( std::is_same< Reg, typename More::reg >::value && ... ), "fields of one register" );
+
+        uint8_t regValue[ 1 ] = { 0 };
+
+        if constexpr ( Reg::shadowed )
+        {
+            regValue[ 0 ] = shadowLoad( Reg::address );
+        }
+        else
+        {
+            readBlock< Reg >( regValue, 1 );
+        }
+
+        regValue[ 0 ] = insert< F, More... >( regValue[ 0 ], ( uint8_t )values... );
+
+        if constexpr ( std::is_same< Reg, REG_SFR >::value )
+        {
+            writeBlock< REG_SF_KEY1 >( { SF_KEY1_VALUE } );
+            writeBlock< REG_SF_KEY2 >( { SF_KEY2_VALUE } );
+        }
+
+        writeBlock< Reg >( regValue );
+    }
+
+    /**
+     * @brief Get date and time function
+     *
+     * @param[out] dateTime          date and time, one burst read
+     */
+    void getDateTime( DateTime &dateTime )
+    {
+        uint8_t rBuffer[ 7 ] = { 0, 0, 0, 0, 0, 0, 0 };
+
+        readBlock< REG_TIME_SEC >( rBuffer, 7 );
+
+        dateTime.timeSeconds = bcdDecode( rBuffer[ 0 ] & 0x7F );
+        dateTime.timeMinutes = bcdDecode( rBuffer[ 1 ] & 0x7F );
+        dateTime.timeHours = bcdDecode( rBuffer[ 2 ] & 0x3F );
+        dateTime.dayOfTheWeek = bcdDecode( rBuffer[ 3 ] & 0x07 );
+        dateTime.dateDay = bcdDecode( rBuffer[ 4 ] & 0x3F );
+        dateTime.dateMonth = bcdDecode( rBuffer[ 5 ] & 0x1F );
+        dateTime.dateYear = bcdDecode( rBuffer[ 6 ] );
+    }
+
+    /**
+     * @brief Set date and time function
+     *
+     * @param[in] dateTime           date and time, one burst write
+     */
+    void setDateTime( const DateTime &dateTime )
+    {
+        writeBlock< REG_TIME_SEC >( {
+            fieldEncode( dateTime.timeSeconds, 60, 0 ),
+            fieldEncode( dateTime.timeMinutes, 60, 0 ),
+            fieldEncode( dateTime.timeHours, 24, 0 ),
+            fieldEncode( dateTime.dayOfTheWeek, 8, 1 ),
+            fieldEncode( dateTime.dateDay, 32, 1 ),
+            fieldEncode( dateTime.dateMonth, 13, 1 ),
+            yearEncode( dateTime.dateYear ) } );
+    }
+
+private:
+
+    uint8_t shadowConfig1;
+    uint8_t shadowTrickleCharge2;
+    uint8_t shadowConfig2;
+    uint8_t shadowSfr;
+
+    template< typename F, typename... More, typename... Values >
+    static constexpr uint8_t insert( uint8_t regValue, uint8_t value, Values... more )
+    {
+        if constexpr ( sizeof...( More ) == 0 )
+        {
+            return F::set( regValue, value );
+        }
+        else
+        {
+            return insert< More... >( F::set( regValue, value ), more... );
+        }
+    }
+
+    uint8_t shadowLoad( uint8_t address ) const
+    {
+        switch ( address )
+        {
+            case REG_CONFIG1::address :         return shadowConfig1;
+            case REG_TRICKLE_CHARGE2::address : return shadowTrickleCharge2;
+            case REG_CONFIG2::address :         return shadowConfig2;
+            default :                           return shadowSfr;
+        }
+    }
+
+    void shadowStore( uint8_t address, uint8_t value )
+    {
+        switch ( address )
+        {
+            case REG_CONFIG1::address :         shadowConfig1 = value;        break;
+            case REG_TRICKLE_CHARGE2::address : shadowTrickleCharge2 = value; break;
+            case REG_CONFIG2::address :         shadowConfig2 = value;        break;
+            case REG_SFR::address :             shadowSfr = value;            break;
+            default :                                                         break;
+        }
+    }
+};
+
+                                                                       /** @} */
+#ifdef __HAL_HOST__
+/** @defgroup RTC3_CPP_SIM Host bus */                        /** @{ */
+
+/**
+ * @brief Bus policy over the BQ32000 simulator bus master
+ */
+struct SimBus
+{
+    static void start()
+    {
+        rtc3sim_masterStart();
+    }
+
+    static void write( uint8_t slave, uint8_t *pBuf, uint16_t nBytes, uint8_t endMode )
+    {
+        rtc3sim_masterWrite( slave, pBuf, nBytes, endMode );
+    }
+
+    static void read( uint8_t slave, uint8_t *pBuf, uint16_t nBytes, uint8_t endMode )
+    {
+        rtc3sim_masterRead( slave, pBuf, nBytes, endMode );
+    }
+};
+
+                                                                       /** @} */
+#endif
+
+} // namespace rtc3
+
+#endif
+/** @} */
+/* -------------------------------------------------------------------------- */
+/*
+  rtc3.hpp
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+3. All advertising materials mentioning features or use of this software
+   must display the following acknowledgement:
+   This product includes software developed by the MikroElektonika.
+
+4. Neither the name of the MikroElektonika nor the
+   names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY MIKROELEKTRONIKA ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL MIKROELEKTRONIKA BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------------- */
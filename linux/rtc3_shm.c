@@ -0,0 +1,161 @@
+/*
+    rtc3_shm.c
+
+-----------------------------------------------------------------------------
+
+  This file is part of mikroSDK.
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+----------------------------------------------------------------------------- */
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "rtc3_shm.h"
+
+/* --------------------------------------------------------- PUBLIC FUNCTIONS */
+
+rtc3_shm_t *rtc3_shmCreate( const char *name )
+{
+    rtc3_shm_t *shm;
+    int fd;
+
+    fd = shm_open( name, O_CREAT | O_RDWR, 0644 );
+
+    if ( fd < 0 )
+    {
+        return 0;
+    }
+
+    if ( ftruncate( fd, sizeof( rtc3_shm_t ) ) != 0 )
+    {
+        close( fd );
+        return 0;
+    }
+
+    shm = ( rtc3_shm_t * )mmap( 0, sizeof( rtc3_shm_t ), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    close( fd );
+
+    if ( shm == MAP_FAILED )
+    {
+        return 0;
+    }
+
+    // Readers see an empty segment until the first publication
+    __atomic_store_n( &shm->sequence, 0, __ATOMIC_RELAXED );
+    __atomic_store_n( &shm->magic, RTC3_SHM_MAGIC, __ATOMIC_RELEASE );
+
+    return shm;
+}
+
+void rtc3_shmPublish( rtc3_shm_t *shm, const rtc3_shmSample_t *sample )
+{
+    uint32_t sequence;
+
+    sequence = __atomic_load_n( &shm->sequence, __ATOMIC_RELAXED );
+
+    // Odd: readers move to copy 1 while copy 0 is rewritten
+    __atomic_store_n( &shm->sequence, sequence + 1, __ATOMIC_RELAXED );
+    __atomic_thread_fence( __ATOMIC_RELEASE );
+    memcpy( &shm->sample[ 0 ], sample, sizeof( rtc3_shmSample_t ) );
+
+    // Even: back to copy 0 while copy 1 is rewritten
+    __atomic_store_n( &shm->sequence, sequence + 2, __ATOMIC_RELEASE );
+    __atomic_thread_fence( __ATOMIC_RELEASE );
+    memcpy( &shm->sample[ 1 ], sample, sizeof( rtc3_shmSample_t ) );
+}
+
+const rtc3_shm_t *rtc3_shmOpen( const char *name )
+{
+    const rtc3_shm_t *shm;
+    int fd;
+
+    fd = shm_open( name, O_RDONLY, 0 );
+
+    if ( fd < 0 )
+    {
+        return 0;
+    }
+
+    shm = ( const rtc3_shm_t * )mmap( 0, sizeof( rtc3_shm_t ), PROT_READ, MAP_SHARED, fd, 0 );
+    close( fd );
+
+    if ( shm == MAP_FAILED )
+    {
+        return 0;
+    }
+
+    if ( __atomic_load_n( &shm->magic, __ATOMIC_ACQUIRE ) != RTC3_SHM_MAGIC )
+    {
+        rtc3_shmClose( shm );
+        return 0;
+    }
+
+    return shm;
+}
+
+uint32_t rtc3_shmRead( const rtc3_shm_t *shm, rtc3_shmSample_t *sample )
+{
+    uint32_t sequence;
+
+    do
+    {
+        sequence = __atomic_load_n( &shm->sequence, __ATOMIC_ACQUIRE );
+
+        memcpy( sample, &shm->sample[ sequence & 1 ], sizeof( rtc3_shmSample_t ) );
+        __atomic_thread_fence( __ATOMIC_ACQUIRE );
+    }
+    while ( __atomic_load_n( &shm->sequence, __ATOMIC_RELAXED ) != sequence );
+
+    return sequence >> 1;
+}
+
+void rtc3_shmClose( const rtc3_shm_t *shm )
+{
+    munmap( ( void * )shm, sizeof( rtc3_shm_t ) );
+}
+
+/* -------------------------------------------------------------------------- */
+/*
+  rtc3_shm.c
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+3. All advertising materials mentioning features or use of this software
+   must display the following acknowledgement:
+   This product includes software developed by the MikroElektonika.
+
+4. Neither the name of the MikroElektonika nor the
+   names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY MIKROELEKTRONIKA ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL MIKROELEKTRONIKA BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------------- */
@@ -0,0 +1,187 @@
+/*
+    rtc3_shm.h
+
+-----------------------------------------------------------------------------
+
+  This file is part of mikroSDK.
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+----------------------------------------------------------------------------- */
+
+/**
+@file   rtc3_shm.h
+@brief    RTC 3 Click shared memory time publisher
+*/
+/**
+@defgroup   RTC3_SHM
+@brief      One BQ32000 reader, any number of local processes
+@{
+
+The rtc3d daemon reads the chip once per second and publishes the result
+into a POSIX shared memory segment. Readers map the segment read only and
+never touch the I2C adapter.
+
+The segment is a single cache line : a sequence counter followed by two
+copies of the last sample. The publisher bumps the counter before each
+copy it rewrites, so readers always have one stable copy to read
+( seqcount latch ). rtc3_shmRead never waits for the publisher, it only
+copies again when the counter moved during its copy, and it writes
+nothing shared, so readers do not slow each other down.
+
+    rtc3_shm_t       *shm;
+    rtc3_shmSample_t sample;
+
+    shm = rtc3_shmOpen( RTC3_SHM_NAME );
+    rtc3_shmRead( shm, &sample );
+
+*/
+/* -------------------------------------------------------------------------- */
+
+#ifndef _RTC3_SHM_H_
+#define _RTC3_SHM_H_
+
+#include <stdint.h>
+
+/** @defgroup RTC3_SHM_VAR Variables */                       /** @{ */
+
+#define RTC3_SHM_NAME                                                     "/rtc3"
+#define RTC3_SHM_MAGIC                                                    0x52544333UL
+
+#define RTC3_SHM_STATUS_OF                                                0x01
+#define RTC3_SHM_STATUS_STOP                                              0x02
+
+                                                                       /** @} */
+/** @defgroup RTC3_SHM_TYPES Types */                         /** @{ */
+
+/**
+ * @brief Published sample
+ */
+typedef struct
+{
+    uint64_t stampNs;                       /**< CLOCK_MONOTONIC time of the 1 Hz edge */
+    uint32_t epoch;                         /**< Unix time of the registers */
+    uint32_t readLatencyNs;                 /**< Duration of the I2C register read */
+    uint8_t  reg[ 7 ];                      /**< Raw BCD registers 0x00 - 0x06 */
+    uint8_t  status;                        /**< RTC3_SHM_STATUS_OF, RTC3_SHM_STATUS_STOP */
+
+}rtc3_shmSample_t;
+
+/**
+ * @brief Shared memory segment
+ *
+ * Counter and both copies share one 64 byte cache line.
+ */
+typedef struct
+{
+    uint32_t            sequence;
+    uint32_t            magic;
+    rtc3_shmSample_t    sample[ 2 ];
+
+}__attribute__(( aligned( 64 ) )) rtc3_shm_t;
+
+                                                                       /** @} */
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/** @defgroup RTC3_SHM_FUNC Functions */                      /** @{ */
+
+/**
+ * @brief Create segment function
+ *
+ * @param[in] name                       POSIX shared memory name, e.g. RTC3_SHM_NAME
+ *
+ * @return Writable mapping, 0 on error
+ *
+ * Function creates or reuses the segment for the publisher.
+ */
+rtc3_shm_t *rtc3_shmCreate( const char *name );
+
+/**
+ * @brief Publish sample function
+ *
+ * @param[in] shm                        segment from rtc3_shmCreate
+ * @param[in] sample                     sample to publish
+ *
+ * Single publisher only.
+ */
+void rtc3_shmPublish( rtc3_shm_t *shm, const rtc3_shmSample_t *sample );
+
+/**
+ * @brief Open segment function
+ *
+ * @param[in] name                       POSIX shared memory name
+ *
+ * @return Read only mapping, 0 when the segment does not exist or
+ *         was not created by rtc3_shmCreate
+ */
+const rtc3_shm_t *rtc3_shmOpen( const char *name );
+
+/**
+ * @brief Read sample function
+ *
+ * @param[in] shm                        segment from rtc3_shmOpen or rtc3_shmCreate
+ * @param[out] sample                    last published sample
+ *
+ * @return Publication count, 0 when nothing was published yet
+ *
+ * Function copies the stable copy of the last sample, repeating the copy
+ * only when a publication happened meanwhile.
+ */
+uint32_t rtc3_shmRead( const rtc3_shm_t *shm, rtc3_shmSample_t *sample );
+
+/**
+ * @brief Close segment function
+ *
+ * @param[in] shm                        segment to unmap
+ */
+void rtc3_shmClose( const rtc3_shm_t *shm );
+
+                                                                       /** @} */
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif
+
+/** @} */
+/* -------------------------------------------------------------------------- */
+/*
+  rtc3_shm.h
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+3. All advertising materials mentioning features or use of this software
+   must display the following acknowledgement:
+   This product includes software developed by the MikroElektonika.
+
+4. Neither the name of the MikroElektonika nor the
+   names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY MIKROELEKTRONIKA ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL MIKROELEKTRONIKA BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------------- */
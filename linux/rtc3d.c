@@ -0,0 +1,309 @@
+/*
+    rtc3d.c
+
+-----------------------------------------------------------------------------
+
+  This file is part of mikroSDK.
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+----------------------------------------------------------------------------- */
+
+/**
+@file   rtc3d.c
+@brief    RTC 3 Click time publisher daemon
+*/
+/**
+@defgroup   RTC3D
+@brief      Reads the BQ32000 once per second into shared memory
+@{
+
+    rtc3d [-d /dev/i2c-1] [-g /dev/gpiochip0 -l line] [-n /rtc3]
+
+With -g and -l the chip drives its 1 Hz calibration output on the INT
+pin, and every rising edge, the seconds rollover, is taken from the GPIO
+character device with its kernel timestamp. The registers are then read
+in one I2C_RDWR transaction and published with rtc3_shmPublish.
+
+Without a GPIO line the daemon polls with rtc3_pollChanged, one register
+per poll, and publishes on every change.
+
+Built with __RTC3D_SIM__ the daemon talks to the BQ32000 simulator
+instead of an adapter, with simulated time following CLOCK_MONOTONIC.
+
+*/
+/* -------------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+
+#include "__rtc3_driver.h"
+#include "rtc3_shm.h"
+
+#ifdef __RTC3D_SIM__
+#include "__rtc3_sim.h"
+#endif
+
+/* ------------------------------------------------------------------- MACROS */
+
+#define _RTC3D_POLL_NS                                                    20000000UL
+
+/* ---------------------------------------------------------------- VARIABLES */
+
+// Same layout as the HAL GPIO object, the daemon does not read pins through the driver
+typedef struct
+{
+    void    (*gpioSet[ 12 ])(uint8_t);
+    uint8_t (*gpioGet[ 12 ])();
+
+}rtc3d_gpio_t;
+
+static const rtc3d_gpio_t   _gpio;
+static rtc3_linuxI2c_t      _bus;
+
+#ifdef __RTC3D_SIM__
+static uint64_t             _simStamp;
+#endif
+
+/* ----------------------------------------------------------- PRIVATE FUNCTIONS */
+
+static uint64_t _nowNs()
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void _sleepNs( uint32_t nanoseconds )
+{
+    struct timespec ts;
+
+    ts.tv_sec = nanoseconds / 1000000000UL;
+    ts.tv_nsec = nanoseconds % 1000000000UL;
+
+    nanosleep( &ts, 0 );
+}
+
+static void _publish( rtc3_shm_t *shm, uint64_t stampNs )
+{
+    rtc3_snapshot_t snapshot;
+    rtc3_datetime_t dateTime;
+    rtc3_shmSample_t sample;
+    uint64_t start;
+
+    start = _nowNs();
+    rtc3_getSnapshot( &snapshot );
+    sample.readLatencyNs = (uint32_t)( _nowNs() - start );
+
+    rtc3_decodeSnapshot( &snapshot, &dateTime );
+
+    memcpy( sample.reg, snapshot.reg, sizeof( sample.reg ) );
+    sample.stampNs = stampNs;
+    sample.epoch = rtc3_dateTimeToEpoch( &dateTime );
+    sample.status = 0;
+
+    if ( snapshot.reg[ 0 ] & 0x80 )
+    {
+        sample.status |= RTC3_SHM_STATUS_STOP;
+    }
+
+    if ( snapshot.reg[ 1 ] & 0x80 )
+    {
+        sample.status |= RTC3_SHM_STATUS_OF;
+    }
+
+    rtc3_shmPublish( shm, &sample );
+}
+
+static int _runEdges( rtc3_shm_t *shm, const char *chip, uint32_t line )
+{
+    struct gpio_v2_line_request req;
+    struct gpio_v2_line_event event;
+    int fd;
+
+    fd = open( chip, O_RDONLY );
+
+    if ( fd < 0 )
+    {
+        perror( chip );
+        return 1;
+    }
+
+    memset( &req, 0, sizeof( req ) );
+    req.offsets[ 0 ] = line;
+    req.num_lines = 1;
+    req.config.flags = GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_EDGE_RISING;
+    strncpy( req.consumer, "rtc3d", sizeof( req.consumer ) - 1 );
+
+    if ( ioctl( fd, GPIO_V2_GET_LINE_IOCTL, &req ) < 0 )
+    {
+        perror( "GPIO_V2_GET_LINE_IOCTL" );
+        close( fd );
+        return 1;
+    }
+
+    close( fd );
+
+    // 1 Hz on INT, rising at every seconds rollover
+    rtc3_enableCalibrationOutput( 1 );
+
+    while ( read( req.fd, &event, sizeof( event ) ) == sizeof( event ) )
+    {
+        _publish( shm, event.timestamp_ns );
+    }
+
+    perror( "gpio event" );
+    close( req.fd );
+
+    return 1;
+}
+
+static int _runPoll( rtc3_shm_t *shm )
+{
+    rtc3_datetime_t dateTime;
+    uint64_t now;
+
+    for ( ; ; )
+    {
+        now = _nowNs();
+
+#ifdef __RTC3D_SIM__
+        rtc3sim_advance( now - _simStamp );
+        _simStamp = now;
+#endif
+
+        if ( rtc3_pollChanged( &dateTime ) != 0 )
+        {
+            _publish( shm, now );
+        }
+
+        _sleepNs( _RTC3D_POLL_NS );
+    }
+
+    return 0;
+}
+
+/* --------------------------------------------------------------------- MAIN */
+
+int main( int argc, char **argv )
+{
+    rtc3_shm_t *shm;
+    const char *device;
+    const char *chip;
+    const char *name;
+    uint32_t line;
+    int opt;
+
+    device = "/dev/i2c-1";
+    chip = 0;
+    name = RTC3_SHM_NAME;
+    line = 0;
+
+    while ( ( opt = getopt( argc, argv, "d:g:l:n:" ) ) != -1 )
+    {
+        switch ( opt )
+        {
+            case 'd' :
+                device = optarg;
+                break;
+            case 'g' :
+                chip = optarg;
+                break;
+            case 'l' :
+                line = (uint32_t)strtoul( optarg, 0, 0 );
+                break;
+            case 'n' :
+                name = optarg;
+                break;
+            default :
+                fprintf( stderr, "usage: %s [-d i2c device] [-g gpio chip -l line] [-n shm name]\n", argv[ 0 ] );
+                return 1;
+        }
+    }
+
+#ifdef __RTC3D_SIM__
+    // The model has no INT line to wait on, poll it
+    ( void )device;
+    chip = 0;
+    rtc3sim_reset();
+    _simStamp = _nowNs();
+    _bus.fd = -1;
+    _bus.ioctlFn = rtc3sim_i2cdevIoctl;
+#else
+    _bus.fd = open( device, O_RDWR );
+    _bus.ioctlFn = 0;
+
+    if ( _bus.fd < 0 )
+    {
+        perror( device );
+        return 1;
+    }
+#endif
+
+    shm = rtc3_shmCreate( name );
+
+    if ( shm == 0 )
+    {
+        perror( name );
+        return 1;
+    }
+
+    rtc3_i2cDriverInit( (T_RTC3_P)&_gpio, (T_RTC3_P)&_bus, _RTC3_I2C_ADDRESS );
+
+    if ( chip != 0 )
+    {
+        return _runEdges( shm, chip, line );
+    }
+
+    return _runPoll( shm );
+}
+
+                                                                       /** @} */
+/* -------------------------------------------------------------------------- */
+/*
+  rtc3d.c
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+3. All advertising materials mentioning features or use of this software
+   must display the following acknowledgement:
+   This product includes software developed by the MikroElektonika.
+
+4. Neither the name of the MikroElektonika nor the
+   names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY MIKROELEKTRONIKA ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL MIKROELEKTRONIKA BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------------- */
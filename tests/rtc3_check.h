@@ -0,0 +1,94 @@
+/*
+    rtc3_check.h
+
+-----------------------------------------------------------------------------
+
+  This file is part of mikroSDK.
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+----------------------------------------------------------------------------- */
+
+/**
+@file   rtc3_check.h
+@brief    RTC 3 Click host test helpers
+*/
+/**
+@defgroup   RTC3_CHECK
+@brief      Minimal check macros shared by the host tests
+@{
+
+Every test is one executable linked against the BQ32000 simulator. A
+failed CHECK prints its location and the test keeps going, CHECK_DONE
+prints the totals and is the exit code of main.
+
+*/
+/* -------------------------------------------------------------------------- */
+
+#ifndef _RTC3_CHECK_H_
+#define _RTC3_CHECK_H_
+
+#include <stdio.h>
+
+static int _checkCount;
+static int _checkFailed;
+
+#define CHECK( cond )                                                          \
+    do                                                                         \
+    {                                                                          \
+        _checkCount++;                                                         \
+        if ( !( cond ) )                                                       \
+        {                                                                      \
+            _checkFailed++;                                                    \
+            printf( "%s:%d: CHECK( %s ) failed\n", __FILE__, __LINE__, #cond ); \
+        }                                                                      \
+    }                                                                          \
+    while ( 0 )
+
+#define CHECK_DONE()                                                           \
+    ( printf( "%-24s %5d checks, %d failed\n", __FILE__, _checkCount, _checkFailed ), \
+      _checkFailed != 0 )
+
+#endif
+
+                                                                       /** @} */
+/* -------------------------------------------------------------------------- */
+/*
+  rtc3_check.h
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+3. All advertising materials mentioning features or use of this software
+   must display the following acknowledgement:
+   This product includes software developed by the MikroElektonika.
+
+4. Neither the name of the MikroElektonika nor the
+   names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY MIKROELEKTRONIKA ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL MIKROELEKTRONIKA BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------------- */
@@ -0,0 +1,177 @@
+/*
+    test_align.c
+
+-----------------------------------------------------------------------------
+
+  This file is part of mikroSDK.
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+----------------------------------------------------------------------------- */
+
+/**
+@file   test_align.c
+@brief    RTC 3 Click aligned set against the BQ32000 simulator
+*/
+/**
+@defgroup   RTC3_TEST_ALIGN
+@brief      rtc3_setDateTimeAligned on a reference second, and its rejections
+@{
+
+    make -C tests check
+
+*/
+/* -------------------------------------------------------------------------- */
+
+#include "__rtc3_driver.h"
+#include "__rtc3_sim.h"
+#include "rtc3_check.h"
+
+/* ------------------------------------------------------------------- MACROS */
+
+#define _NS_PER_SECOND                                                    1000000000ULL
+#define _COUNTER_HZ                                                       1000000UL
+
+/* ----------------------------------------------------------- PRIVATE FUNCTIONS */
+
+// 1 MHz counter, every read lets 10 us of simulated time pass
+static uint32_t _counter()
+{
+    rtc3sim_advance( 10000 );
+
+    return (uint32_t)( rtc3sim_getTime() / 1000 );
+}
+
+static uint32_t _stopped()
+{
+    return 1234;
+}
+
+static void _init( rtc3_datetime_t *dateTime )
+{
+    rtc3sim_reset();
+    rtc3_i2cDriverInit( (T_RTC3_P)&_HOST_MIKROBUS_GPIO, (T_RTC3_P)&_HOST_MIKROBUS_I2C, _RTC3_I2C_ADDRESS );
+    rtc3_enableCounting();
+    rtc3sim_advance( _NS_PER_SECOND / 2 );
+
+    // Four digit year, the aligned set carries it over the new year
+    dateTime->timeSeconds = 58;
+    dateTime->timeMinutes = 59;
+    dateTime->timeHours = 23;
+    dateTime->dayOfTheWeek = 2;
+    dateTime->dateDay = 31;
+    dateTime->dateMonth = 12;
+    dateTime->dateYear = 2024;
+}
+
+// Simulated time up to the given counter value
+static void _advanceTo( uint32_t stamp )
+{
+    rtc3sim_advance( (uint64_t)stamp * 1000 - rtc3sim_getTime() );
+}
+
+/* -------------------------------------------------------------------- TESTS */
+
+static void _testBoundary()
+{
+    rtc3_datetime_t dateTime;
+    rtc3_datetime_t now;
+    uint32_t refStamp;
+    uint32_t latency;
+
+    _init( &dateTime );
+    refStamp = _counter();
+    rtc3sim_advance( _NS_PER_SECOND * 13 / 10 );
+
+    // Set behind the driver's back, the shadow is stale
+    rtc3sim_poke( _RTC3_REG_CONFIG1, 0x45 );
+
+    // 1.3 sec old, the write lands on refStamp + 2 sec
+    CHECK( rtc3_setDateTimeAligned( &dateTime, _counter, _COUNTER_HZ, refStamp, &latency ) == 0 );
+    CHECK( latency > 0 );
+    CHECK( _counter() - refStamp < 2 * _COUNTER_HZ + 2000 );
+
+    rtc3_getDateTime( &now );
+    CHECK( now.timeSeconds == 0 && now.timeMinutes == 0 && now.timeHours == 0 );
+    CHECK( now.dateDay == 1 && now.dateMonth == 1 && now.dateYear == 25 );
+    CHECK( now.dayOfTheWeek == 3 );
+    CHECK( rtc3sim_peek( _RTC3_REG_CONFIG1 ) == 0x45 );
+
+    // The countdown chain restarted on the boundary
+    _advanceTo( refStamp + 3 * _COUNTER_HZ - 2000 );
+    CHECK( rtc3_getTimeSeconds() == 0 );
+    _advanceTo( refStamp + 3 * _COUNTER_HZ + 1000 );
+    CHECK( rtc3_getTimeSeconds() == 1 );
+}
+
+static void _testReject()
+{
+    rtc3_datetime_t dateTime;
+    uint32_t latency;
+    uint32_t now;
+
+    _init( &dateTime );
+    now = _counter();
+
+    // Future, too old, stopped counter, counter too fast to fit 32 bits
+    CHECK( rtc3_setDateTimeAligned( &dateTime, _counter, _COUNTER_HZ, now + 100000UL, &latency ) == 1 );
+    CHECK( rtc3_setDateTimeAligned( &dateTime, _counter, _COUNTER_HZ, now - 5 * _COUNTER_HZ, &latency ) == 1 );
+    CHECK( rtc3_setDateTimeAligned( &dateTime, _stopped, _COUNTER_HZ, 1234, &latency ) == 1 );
+    CHECK( rtc3_setDateTimeAligned( &dateTime, _counter, 0, now, &latency ) == 1 );
+    CHECK( rtc3_setDateTimeAligned( &dateTime, _counter, 1000000000UL, now, &latency ) == 1 );
+
+    // Nothing written, the clock still runs from the reset date
+    CHECK( rtc3_getDateYear() != 24 );
+}
+
+/* --------------------------------------------------------------------- MAIN */
+
+int main()
+{
+    _testBoundary();
+    _testReject();
+
+    return CHECK_DONE();
+}
+
+                                                                       /** @} */
+/* -------------------------------------------------------------------------- */
+/*
+  test_align.c
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+3. All advertising materials mentioning features or use of this software
+   must display the following acknowledgement:
+   This product includes software developed by the MikroElektonika.
+
+4. Neither the name of the MikroElektonika nor the
+   names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY MIKROELEKTRONIKA ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL MIKROELEKTRONIKA BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------------- */
@@ -0,0 +1,255 @@
+/*
+    test_async.c
+
+-----------------------------------------------------------------------------
+
+  This file is part of mikroSDK.
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+----------------------------------------------------------------------------- */
+
+/**
+@file   test_async.c
+@brief    RTC 3 Click interrupt driven transfers against the BQ32000 simulator
+*/
+/**
+@defgroup   RTC3_TEST_ASYNC
+@brief      _asyncStep through every state, address NACK included
+@{
+
+The driver is included rather than linked, so the test sees the engine
+states. Simulated time is moved 1 us per rtc3_ctxPoll, well below one
+bit time, so every state the engine passes through is recorded.
+
+    make -C tests check
+
+*/
+/* -------------------------------------------------------------------------- */
+
+#include "__rtc3_driver.c"
+#include "__rtc3_sim.h"
+#include "rtc3_check.h"
+
+/* ------------------------------------------------------------------- MACROS */
+
+#define _TRACE_MAX                                                        32
+
+/* ---------------------------------------------------------------- VARIABLES */
+
+static rtc3_t   _ctx;
+static uint8_t  _trace[ _TRACE_MAX ];
+static uint8_t  _traceCount;
+static uint8_t  _doneCount;
+static uint8_t  _doneError;
+
+/* ----------------------------------------------------------- PRIVATE FUNCTIONS */
+
+static void _done( uint8_t error )
+{
+    _doneCount++;
+    _doneError = error;
+}
+
+static void _init( uint8_t slave )
+{
+    rtc3sim_reset();
+    rtc3_ctxI2cDriverInit( &_ctx, (T_RTC3_P)&_HOST_MIKROBUS_GPIO, (T_RTC3_P)&_HOST_MIKROBUS_I2C, slave );
+
+    _doneCount = 0;
+    _doneError = 0;
+}
+
+// Poll to completion, recording every state change
+static void _run()
+{
+    uint32_t polls;
+
+    _traceCount = 0;
+    _trace[ _traceCount++ ] = _ctx.asyncState;
+
+    for ( polls = 0; ( polls < 100000 ) && rtc3_ctxAsyncBusy( &_ctx ); polls++ )
+    {
+        rtc3sim_advance( 1000 );
+        rtc3_ctxPoll( &_ctx );
+
+        if ( ( _ctx.asyncState != _trace[ _traceCount - 1 ] ) && ( _traceCount < _TRACE_MAX ) )
+        {
+            _trace[ _traceCount++ ] = _ctx.asyncState;
+        }
+    }
+}
+
+static int _traced( const uint8_t *expected, uint8_t count )
+{
+    uint8_t cnt;
+
+    if ( count != _traceCount )
+    {
+        return 0;
+    }
+
+    for ( cnt = 0; cnt < count; cnt++ )
+    {
+        if ( _trace[ cnt ] != expected[ cnt ] )
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/* -------------------------------------------------------------------- TESTS */
+
+static void _testRead()
+{
+    static const uint8_t expected[] =
+    {
+        _RTC3_ASYNC_START, _RTC3_ASYNC_ADDRESS_WRITE, _RTC3_ASYNC_POINTER, _RTC3_ASYNC_RESTART,
+        _RTC3_ASYNC_ADDRESS_READ, _RTC3_ASYNC_DATA, _RTC3_ASYNC_STOP, _RTC3_ASYNC_IDLE
+    };
+    uint8_t rBuffer[ 3 ];
+
+    _init( _RTC3_I2C_ADDRESS );
+    rtc3sim_poke( _RTC3_REG_TIME_SEC, 0x12 );
+    rtc3sim_poke( _RTC3_REG_TIME_MIN, 0x34 );
+    rtc3sim_poke( _RTC3_REG_TIME_HOUR, 0x05 );
+
+    CHECK( rtc3_ctxReadBlockAsync( &_ctx, _RTC3_REG_TIME_SEC, rBuffer, 3, _done ) == 0 );
+
+    // Only one transfer at a time
+    CHECK( rtc3_ctxReadBlockAsync( &_ctx, _RTC3_REG_TIME_SEC, rBuffer, 3, _done ) == 1 );
+
+    _run();
+    CHECK( _traced( expected, sizeof( expected ) ) );
+    CHECK( _doneCount == 1 );
+    CHECK( _doneError == 0 );
+    CHECK( rBuffer[ 0 ] == 0x12 );
+    CHECK( rBuffer[ 1 ] == 0x34 );
+    CHECK( rBuffer[ 2 ] == 0x05 );
+}
+
+static void _testWrite()
+{
+    static const uint8_t expected[] =
+    {
+        _RTC3_ASYNC_START, _RTC3_ASYNC_ADDRESS_WRITE, _RTC3_ASYNC_POINTER,
+        _RTC3_ASYNC_DATA, _RTC3_ASYNC_STOP, _RTC3_ASYNC_IDLE
+    };
+    uint8_t wBuffer[ 2 ] = { 0x21, 0x13 };
+
+    _init( _RTC3_I2C_ADDRESS );
+
+    CHECK( rtc3_ctxWriteBlockAsync( &_ctx, _RTC3_REG_TIME_MIN, wBuffer, 2, _done ) == 0 );
+
+    _run();
+    CHECK( _traced( expected, sizeof( expected ) ) );
+    CHECK( _doneCount == 1 );
+    CHECK( _doneError == 0 );
+    CHECK( rtc3sim_peek( _RTC3_REG_TIME_MIN ) == 0x21 );
+    CHECK( rtc3sim_peek( _RTC3_REG_TIME_HOUR ) == 0x13 );
+}
+
+static void _testPointerOnly()
+{
+    static const uint8_t expected[] =
+    {
+        _RTC3_ASYNC_START, _RTC3_ASYNC_ADDRESS_WRITE, _RTC3_ASYNC_POINTER,
+        _RTC3_ASYNC_STOP, _RTC3_ASYNC_IDLE
+    };
+
+    // No data bytes, the pointer write goes straight to the STOP
+    _init( _RTC3_I2C_ADDRESS );
+
+    CHECK( rtc3_ctxWriteBlockAsync( &_ctx, _RTC3_REG_TIME_MIN, 0, 0, _done ) == 0 );
+
+    _run();
+    CHECK( _traced( expected, sizeof( expected ) ) );
+    CHECK( _doneError == 0 );
+}
+
+static void _testNack()
+{
+    static const uint8_t expected[] =
+    {
+        _RTC3_ASYNC_START, _RTC3_ASYNC_ADDRESS_WRITE, _RTC3_ASYNC_STOP, _RTC3_ASYNC_IDLE
+    };
+    rtc3_datetime_t dateTime;
+
+    // Nothing answers at 0x69, the address byte is NACKed and the bus released
+    _init( 0x69 );
+    rtc3sim_poke( _RTC3_REG_TIME_SEC, 0x12 );
+
+    dateTime.timeSeconds = 0x55;
+    CHECK( rtc3_ctxGetDateTimeAsync( &_ctx, &dateTime, _done ) == 0 );
+
+    _run();
+    CHECK( _traced( expected, sizeof( expected ) ) );
+    CHECK( _doneCount == 1 );
+    CHECK( _doneError == 1 );
+    CHECK( dateTime.timeSeconds == 0x55 );
+
+    // The engine is usable again at the right address
+    _ctx.slaveAddress = _RTC3_I2C_ADDRESS;
+    CHECK( rtc3_ctxGetDateTimeAsync( &_ctx, &dateTime, _done ) == 0 );
+
+    _run();
+    CHECK( _doneCount == 2 );
+    CHECK( _doneError == 0 );
+    CHECK( dateTime.timeSeconds == 12 );
+}
+
+/* --------------------------------------------------------------------- MAIN */
+
+int main()
+{
+    _testRead();
+    _testWrite();
+    _testPointerOnly();
+    _testNack();
+
+    return CHECK_DONE();
+}
+
+                                                                       /** @} */
+/* -------------------------------------------------------------------------- */
+/*
+  test_async.c
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+3. All advertising materials mentioning features or use of this software
+   must display the following acknowledgement:
+   This product includes software developed by the MikroElektonika.
+
+4. Neither the name of the MikroElektonika nor the
+   names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY MIKROELEKTRONIKA ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL MIKROELEKTRONIKA BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------------- */
@@ -0,0 +1,164 @@
+/*
+    test_clock.c
+
+-----------------------------------------------------------------------------
+
+  This file is part of mikroSDK.
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+----------------------------------------------------------------------------- */
+
+/**
+@file   test_clock.c
+@brief    RTC 3 Click software clock against the BQ32000 simulator
+*/
+/**
+@defgroup   RTC3_TEST_CLOCK
+@brief      rtc3_clockStart edge wait and rtc3_clockGet
+@{
+
+    make -C tests check
+
+*/
+/* -------------------------------------------------------------------------- */
+
+#include "__rtc3_driver.h"
+#include "__rtc3_sim.h"
+#include "rtc3_check.h"
+
+/* ------------------------------------------------------------------- MACROS */
+
+#define _NS_PER_SECOND                                                    1000000000ULL
+#define _COUNTER_HZ                                                       1000000UL
+
+/* ----------------------------------------------------------- PRIVATE FUNCTIONS */
+
+// 1 MHz counter, every read lets 10 us of simulated time pass
+static uint32_t _counter()
+{
+    rtc3sim_advance( 10000 );
+
+    return (uint32_t)( rtc3sim_getTime() / 1000 );
+}
+
+static void _init()
+{
+    rtc3_datetime_t dateTime;
+
+    rtc3sim_reset();
+    rtc3_i2cDriverInit( (T_RTC3_P)&_HOST_MIKROBUS_GPIO, (T_RTC3_P)&_HOST_MIKROBUS_I2C, _RTC3_I2C_ADDRESS );
+
+    dateTime.timeSeconds = 58;
+    dateTime.timeMinutes = 59;
+    dateTime.timeHours = 23;
+    dateTime.dayOfTheWeek = 2;
+    dateTime.dateDay = 31;
+    dateTime.dateMonth = 12;
+    dateTime.dateYear = 2024;
+
+    rtc3_setDateTime( &dateTime );
+}
+
+/* -------------------------------------------------------------------- TESTS */
+
+static void _testStart()
+{
+    rtc3_datetime_t dateTime;
+    uint16_t ms;
+    uint64_t start;
+
+    _init();
+    rtc3sim_advance( _NS_PER_SECOND / 4 );
+
+    // Starts on the next rollover, 750 ms and the edge later
+    start = rtc3sim_getTime();
+    CHECK( rtc3_clockStart( _counter, _COUNTER_HZ, 0 ) == 0 );
+    CHECK( rtc3sim_getTime() - start < _NS_PER_SECOND );
+
+    rtc3_clockGet( &dateTime, &ms );
+    CHECK( dateTime.timeSeconds == 59 );
+    CHECK( dateTime.dateYear == 24 );
+    CHECK( ms < 10 );
+
+    rtc3sim_advance( _NS_PER_SECOND / 2 );
+    rtc3_clockGet( &dateTime, &ms );
+    CHECK( ( ms >= 500 ) && ( ms < 510 ) );
+
+    // Edges advance the RAM copy, through the year end
+    rtc3_clockEdge();
+    rtc3_clockGet( &dateTime, 0 );
+    CHECK( dateTime.timeSeconds == 0 );
+    CHECK( dateTime.dateDay == 1 );
+    CHECK( dateTime.dateMonth == 1 );
+    CHECK( dateTime.dateYear == 25 );
+}
+
+static void _testNoEdge()
+{
+    uint64_t start;
+
+    // Counting stopped, no 1 Hz edges, the wait gives up after 2 sec
+    _init();
+    rtc3_disableCounting();
+
+    start = rtc3sim_getTime();
+    CHECK( rtc3_clockStart( _counter, _COUNTER_HZ, 0 ) == 1 );
+    CHECK( rtc3sim_getTime() - start >= 2 * _NS_PER_SECOND );
+    CHECK( rtc3sim_getTime() - start < 3 * _NS_PER_SECOND );
+
+    // Without a counter it is bounded by INT pin reads
+    CHECK( rtc3_clockStart( 0, 0, 0 ) == 1 );
+}
+
+/* --------------------------------------------------------------------- MAIN */
+
+int main()
+{
+    _testStart();
+    _testNoEdge();
+
+    return CHECK_DONE();
+}
+
+                                                                       /** @} */
+/* -------------------------------------------------------------------------- */
+/*
+  test_clock.c
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+3. All advertising materials mentioning features or use of this software
+   must display the following acknowledgement:
+   This product includes software developed by the MikroElektonika.
+
+4. Neither the name of the MikroElektonika nor the
+   names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY MIKROELEKTRONIKA ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL MIKROELEKTRONIKA BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------------- */
@@ -0,0 +1,222 @@
+/*
+    test_dma.c
+
+-----------------------------------------------------------------------------
+
+  This file is part of mikroSDK.
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+----------------------------------------------------------------------------- */
+
+/**
+@file   test_dma.c
+@brief    RTC 3 Click DMA transfers against the BQ32000 simulator
+*/
+/**
+@defgroup   RTC3_TEST_DMA
+@brief      Completion, NACK and busy channel paths with __HAL_I2C_DMA__
+@{
+
+Built with __HAL_STATS__ as well, so the accounting of transfers that
+bypass the bus wrappers is checked on the same paths.
+
+    make -C tests check
+
+*/
+/* -------------------------------------------------------------------------- */
+
+#include "__rtc3_driver.h"
+#include "__rtc3_sim.h"
+#include "rtc3_check.h"
+
+/* ---------------------------------------------------------------- VARIABLES */
+
+static uint8_t  _doneCount;
+static uint8_t  _doneError;
+
+/* ----------------------------------------------------------- PRIVATE FUNCTIONS */
+
+static void _done( uint8_t error )
+{
+    _doneCount++;
+    _doneError = error;
+}
+
+static void _init( uint8_t slave )
+{
+    rtc3sim_reset();
+    rtc3_i2cDriverInit( (T_RTC3_P)&_HOST_MIKROBUS_GPIO, (T_RTC3_P)&_HOST_MIKROBUS_I2C, slave );
+    rtc3_resetStats();
+
+    _doneCount = 0;
+    _doneError = 0;
+}
+
+// Poll every 10 us of simulated time, returns the number of polls
+static uint32_t _run()
+{
+    uint32_t polls;
+
+    for ( polls = 0; ( polls < 100000 ) && rtc3_asyncBusy(); polls++ )
+    {
+        rtc3sim_advance( 10000 );
+        rtc3_poll();
+    }
+
+    return polls;
+}
+
+/* -------------------------------------------------------------------- TESTS */
+
+static void _testRead()
+{
+    rtc3_datetime_t dateTime;
+    rtc3_stats_t stats;
+    uint64_t start;
+    uint32_t polls;
+
+    _init( _RTC3_I2C_ADDRESS );
+    rtc3sim_poke( _RTC3_REG_TIME_SEC, 0x56 );
+    rtc3sim_poke( _RTC3_REG_TIME_DATE_YEAR, 0x24 );
+
+    // The start returns without any bus time passing
+    start = rtc3sim_getTime();
+    CHECK( rtc3_getDateTimeAsync( &dateTime, _done ) == 0 );
+    CHECK( rtc3sim_getTime() == start );
+    CHECK( rtc3_asyncBusy() );
+    CHECK( rtc3_getDateTimeAsync( &dateTime, _done ) == 1 );
+
+    // Address, pointer, address and 7 bytes, 10 bytes at 100 kHz
+    polls = _run();
+    CHECK( polls > 80 );
+    CHECK( polls < 120 );
+    CHECK( _doneCount == 1 );
+    CHECK( _doneError == 0 );
+    CHECK( dateTime.timeSeconds == 56 );
+    CHECK( dateTime.dateYear == 24 );
+
+    rtc3_getStats( &stats );
+    CHECK( stats.transactions == 1 );
+    CHECK( stats.restarts == 1 );
+    CHECK( stats.bytesWritten == 3 );
+    CHECK( stats.bytesRead == 7 );
+    CHECK( stats.errors == 0 );
+    CHECK( stats.calls == 1 );
+
+    // Nothing more is reported once complete
+    rtc3_poll();
+    CHECK( _doneCount == 1 );
+}
+
+static void _testWrite()
+{
+    uint8_t wBuffer[ 2 ] = { 0x45, 0x11 };
+    rtc3_stats_t stats;
+
+    _init( _RTC3_I2C_ADDRESS );
+
+    CHECK( rtc3_writeBlockAsync( _RTC3_REG_TIME_MIN, wBuffer, 2, _done ) == 0 );
+    _run();
+    CHECK( _doneCount == 1 );
+    CHECK( _doneError == 0 );
+    CHECK( rtc3sim_peek( _RTC3_REG_TIME_MIN ) == 0x45 );
+    CHECK( rtc3sim_peek( _RTC3_REG_TIME_HOUR ) == 0x11 );
+
+    rtc3_getStats( &stats );
+    CHECK( stats.bytesWritten == 4 );
+    CHECK( stats.bytesRead == 0 );
+}
+
+static void _testNack()
+{
+    rtc3_datetime_t dateTime;
+    rtc3_stats_t stats;
+
+    // Nothing answers at 0x69, the channel aborts on the address byte
+    _init( 0x69 );
+
+    dateTime.timeSeconds = 0x55;
+    CHECK( rtc3_getDateTimeAsync( &dateTime, _done ) == 0 );
+    CHECK( _run() < 15 );
+    CHECK( _doneCount == 1 );
+    CHECK( _doneError == 1 );
+    CHECK( dateTime.timeSeconds == 0x55 );
+
+    rtc3_getStats( &stats );
+    CHECK( stats.errors == 1 );
+    CHECK( stats.transactions == 1 );
+}
+
+static void _testChannelBusy()
+{
+    rtc3_datetime_t dateTime;
+
+    _init( _RTC3_I2C_ADDRESS );
+    rtc3sim_poke( _RTC3_REG_TIME_SEC, 0x07 );
+
+    // Peripheral in use, the driver moves the data with the blocking master
+    rtc3sim_i2cStart();
+    CHECK( rtc3_getDateTimeAsync( &dateTime, _done ) == 0 );
+    CHECK( _doneCount == 0 );
+
+    rtc3_poll();
+    CHECK( _doneCount == 1 );
+    CHECK( _doneError == 0 );
+    CHECK( dateTime.timeSeconds == 7 );
+    CHECK( rtc3_asyncBusy() == 0 );
+}
+
+/* --------------------------------------------------------------------- MAIN */
+
+int main()
+{
+    _testRead();
+    _testWrite();
+    _testNack();
+    _testChannelBusy();
+
+    return CHECK_DONE();
+}
+
+                                                                       /** @} */
+/* -------------------------------------------------------------------------- */
+/*
+  test_dma.c
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+3. All advertising materials mentioning features or use of this software
+   must display the following acknowledgement:
+   This product includes software developed by the MikroElektonika.
+
+4. Neither the name of the MikroElektonika nor the
+   names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY MIKROELEKTRONIKA ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL MIKROELEKTRONIKA BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------------- */
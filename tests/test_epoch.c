@@ -0,0 +1,204 @@
+/*
+    test_epoch.c
+
+-----------------------------------------------------------------------------
+
+  This file is part of mikroSDK.
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+----------------------------------------------------------------------------- */
+
+/**
+@file   test_epoch.c
+@brief    RTC 3 Click epoch conversions against the C library
+*/
+/**
+@defgroup   RTC3_TEST_EPOCH
+@brief      rtc3_epochToDateTime and rtc3_dateTimeToEpoch against gmtime_r and timegm
+@{
+
+Every day of 2000 - 2099 at the second-of-day boundaries, every second
+around the leap days and year ends, and the clamping at both ends.
+
+    make -C tests check
+
+*/
+/* -------------------------------------------------------------------------- */
+
+#define _DEFAULT_SOURCE
+
+#include <time.h>
+
+#include "__rtc3_driver.h"
+#include "rtc3_check.h"
+
+/* ------------------------------------------------------------------- MACROS */
+
+#define _SECONDS_PER_DAY                                                  86400UL
+
+/* ---------------------------------------------------------------- VARIABLES */
+
+static const uint32_t _secondOfDay[] = { 0, 1, 59, 60, 3599, 3600, 43199, 43200, 86340, 86399 };
+
+/* ----------------------------------------------------------- PRIVATE FUNCTIONS */
+
+static int _matches( uint32_t epoch )
+{
+    rtc3_datetime_t dateTime;
+    struct tm tm;
+    time_t t;
+
+    t = (time_t)epoch;
+    gmtime_r( &t, &tm );
+    rtc3_epochToDateTime( epoch, &dateTime );
+
+    // Two digit year, 1 - Monday ... 7 - Sunday
+    if ( ( dateTime.dateYear != tm.tm_year - 100 ) || ( dateTime.dateMonth != tm.tm_mon + 1 ) ||
+         ( dateTime.dateDay != tm.tm_mday ) || ( dateTime.timeHours != tm.tm_hour ) ||
+         ( dateTime.timeMinutes != tm.tm_min ) || ( dateTime.timeSeconds != tm.tm_sec ) ||
+         ( dateTime.dayOfTheWeek != ( ( tm.tm_wday == 0 ) ? 7 : tm.tm_wday ) ) )
+    {
+        return 0;
+    }
+
+    if ( rtc3_dateTimeToEpoch( &dateTime ) != epoch )
+    {
+        return 0;
+    }
+
+    // The four digit form gives the same epoch
+    dateTime.dateYear += 2000;
+
+    return ( rtc3_dateTimeToEpoch( &dateTime ) == (uint32_t)timegm( &tm ) );
+}
+
+/* -------------------------------------------------------------------- TESTS */
+
+static void _testDays()
+{
+    uint32_t day;
+    uint32_t failed;
+    uint8_t cnt;
+
+    failed = 0;
+
+    for ( day = _RTC3_EPOCH_MIN / _SECONDS_PER_DAY; day <= _RTC3_EPOCH_MAX / _SECONDS_PER_DAY; day++ )
+    {
+        for ( cnt = 0; cnt < sizeof( _secondOfDay ) / sizeof( _secondOfDay[ 0 ] ); cnt++ )
+        {
+            failed += !_matches( day * _SECONDS_PER_DAY + _secondOfDay[ cnt ] );
+        }
+    }
+
+    CHECK( failed == 0 );
+}
+
+static void _testBoundaries()
+{
+    static const uint16_t year[] = { 2000, 2001, 2004, 2023, 2024, 2096, 2098 };
+    struct tm tm = { 0 };
+    uint32_t epoch;
+    uint32_t failed;
+    uint8_t cnt;
+
+    failed = 0;
+
+    for ( cnt = 0; cnt < sizeof( year ) / sizeof( year[ 0 ] ); cnt++ )
+    {
+        // Feb 28th to Mar 2nd and Dec 31st to Jan 1st, every second
+        tm.tm_year = year[ cnt ] - 1900;
+        tm.tm_mon = 1;
+        tm.tm_mday = 28;
+
+        for ( epoch = (uint32_t)timegm( &tm ); epoch < (uint32_t)timegm( &tm ) + 3 * _SECONDS_PER_DAY; epoch++ )
+        {
+            failed += !_matches( epoch );
+        }
+
+        tm.tm_mon = 11;
+        tm.tm_mday = 31;
+
+        for ( epoch = (uint32_t)timegm( &tm ); epoch < (uint32_t)timegm( &tm ) + 2 * _SECONDS_PER_DAY; epoch++ )
+        {
+            failed += !_matches( epoch );
+        }
+
+        tm.tm_mon = 0;
+        tm.tm_mday = 1;
+    }
+
+    CHECK( failed == 0 );
+    CHECK( _matches( _RTC3_EPOCH_MIN ) );
+    CHECK( _matches( _RTC3_EPOCH_MAX ) );
+}
+
+static void _testClamp()
+{
+    rtc3_datetime_t dateTime;
+
+    rtc3_epochToDateTime( 0, &dateTime );
+    CHECK( rtc3_dateTimeToEpoch( &dateTime ) == _RTC3_EPOCH_MIN );
+
+    rtc3_epochToDateTime( _RTC3_EPOCH_MIN - 1, &dateTime );
+    CHECK( rtc3_dateTimeToEpoch( &dateTime ) == _RTC3_EPOCH_MIN );
+
+    rtc3_epochToDateTime( _RTC3_EPOCH_MAX + 1, &dateTime );
+    CHECK( rtc3_dateTimeToEpoch( &dateTime ) == _RTC3_EPOCH_MAX );
+
+    rtc3_epochToDateTime( 0xFFFFFFFFUL, &dateTime );
+    CHECK( rtc3_dateTimeToEpoch( &dateTime ) == _RTC3_EPOCH_MAX );
+}
+
+/* --------------------------------------------------------------------- MAIN */
+
+int main()
+{
+    _testDays();
+    _testBoundaries();
+    _testClamp();
+
+    return CHECK_DONE();
+}
+
+                                                                       /** @} */
+/* -------------------------------------------------------------------------- */
+/*
+  test_epoch.c
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+3. All advertising materials mentioning features or use of this software
+   must display the following acknowledgement:
+   This product includes software developed by the MikroElektonika.
+
+4. Neither the name of the MikroElektonika nor the
+   names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY MIKROELEKTRONIKA ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL MIKROELEKTRONIKA BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------------- */
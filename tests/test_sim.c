@@ -0,0 +1,323 @@
+/*
+    test_sim.c
+
+-----------------------------------------------------------------------------
+
+  This file is part of mikroSDK.
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+----------------------------------------------------------------------------- */
+
+/**
+@file   test_sim.c
+@brief    RTC 3 Click driver against the BQ32000 simulator
+*/
+/**
+@defgroup   RTC3_TEST_SIM
+@brief      Burst transfers, SF keys, STOP / OF, calibration, rollovers and NACKs
+@{
+
+    make -C tests check
+
+*/
+/* -------------------------------------------------------------------------- */
+
+#include "__rtc3_driver.h"
+#include "__rtc3_sim.h"
+#include "rtc3_check.h"
+
+/* ------------------------------------------------------------------- MACROS */
+
+#define _NS_PER_SECOND                                                    1000000000ULL
+
+/* ----------------------------------------------------------- PRIVATE FUNCTIONS */
+
+static void _init()
+{
+    rtc3sim_reset();
+    rtc3_i2cDriverInit( (T_RTC3_P)&_HOST_MIKROBUS_GPIO, (T_RTC3_P)&_HOST_MIKROBUS_I2C, _RTC3_I2C_ADDRESS );
+}
+
+static void _set( uint16_t year, uint8_t month, uint8_t day, uint8_t wDay, uint8_t hours, uint8_t minutes, uint8_t seconds )
+{
+    rtc3_datetime_t dateTime;
+
+    dateTime.timeSeconds = seconds;
+    dateTime.timeMinutes = minutes;
+    dateTime.timeHours = hours;
+    dateTime.dayOfTheWeek = wDay;
+    dateTime.dateDay = day;
+    dateTime.dateMonth = month;
+    dateTime.dateYear = year;
+
+    rtc3_setDateTime( &dateTime );
+}
+
+static int _is( uint16_t year, uint8_t month, uint8_t day, uint8_t wDay, uint8_t hours, uint8_t minutes, uint8_t seconds )
+{
+    rtc3_datetime_t dateTime;
+
+    rtc3_getDateTime( &dateTime );
+
+    return ( dateTime.dateYear == year ) && ( dateTime.dateMonth == month ) &&
+           ( dateTime.dateDay == day ) && ( dateTime.dayOfTheWeek == wDay ) &&
+           ( dateTime.timeHours == hours ) && ( dateTime.timeMinutes == minutes ) &&
+           ( dateTime.timeSeconds == seconds );
+}
+
+/* -------------------------------------------------------------------- TESTS */
+
+static void _testBurst()
+{
+    uint8_t wBuffer[ 7 ] = { 0x45, 0x59, 0x23, 0x07, 0x31, 0x12, 0x99 };
+    uint8_t rBuffer[ 7 ];
+    uint8_t cnt;
+
+    _init();
+    rtc3_writeBlock( _RTC3_REG_TIME_SEC, wBuffer, 7 );
+
+    for ( cnt = 0; cnt < 7; cnt++ )
+    {
+        CHECK( rtc3sim_peek( cnt ) == wBuffer[ cnt ] );
+    }
+
+    rtc3_readBlock( _RTC3_REG_TIME_SEC, rBuffer, 7 );
+
+    for ( cnt = 0; cnt < 7; cnt++ )
+    {
+        CHECK( rBuffer[ cnt ] == wBuffer[ cnt ] );
+    }
+
+    // Pointer auto-increment from the middle of the file
+    rtc3_readBlock( _RTC3_REG_TIME_DATE_DAY, rBuffer, 3 );
+    CHECK( rBuffer[ 0 ] == 0x31 );
+    CHECK( rBuffer[ 1 ] == 0x12 );
+    CHECK( rBuffer[ 2 ] == 0x99 );
+
+    // A burst read is latched at its START, a rollover during it is not seen
+    _set( 2023, 12, 31, 7, 23, 59, 59 );
+    rtc3sim_advance( _NS_PER_SECOND - 20000000 );
+    rtc3sim_setBusTiming( 1000, 0 );
+    rtc3_readBlock( _RTC3_REG_TIME_SEC, rBuffer, 7 );
+    rtc3sim_setBusTiming( 100000, 0 );
+    CHECK( rBuffer[ 0 ] == 0x59 );
+    CHECK( rBuffer[ 6 ] == 0x23 );
+    CHECK( rtc3sim_peek( _RTC3_REG_TIME_DATE_YEAR ) == 0x24 );
+}
+
+static void _testSfKeys()
+{
+    _init();
+
+    // SFR ignores writes without the key sequence
+    rtc3_writeByte( _RTC3_REG_SFR, 0x01 );
+    CHECK( rtc3sim_peek( _RTC3_REG_SFR ) == 0x00 );
+
+    // Keys out of order
+    rtc3_writeByte( _RTC3_REG_SF_KEY2, _RTC3SIM_SF_KEY2 );
+    rtc3_writeByte( _RTC3_REG_SF_KEY1, _RTC3SIM_SF_KEY1 );
+    rtc3_writeByte( _RTC3_REG_SFR, 0x01 );
+    CHECK( rtc3sim_peek( _RTC3_REG_SFR ) == 0x00 );
+
+    // Another register between the keys and the SFR
+    rtc3_writeByte( _RTC3_REG_SF_KEY1, _RTC3SIM_SF_KEY1 );
+    rtc3_writeByte( _RTC3_REG_SF_KEY2, _RTC3SIM_SF_KEY2 );
+    rtc3_writeByte( _RTC3_REG_CONFIG2, 0x00 );
+    rtc3_writeByte( _RTC3_REG_SFR, 0x01 );
+    CHECK( rtc3sim_peek( _RTC3_REG_SFR ) == 0x00 );
+
+    rtc3_setSpecialFunctionKey1( _RTC3SIM_SF_KEY1 );
+    rtc3_setSpecialFunctionKey2( _RTC3SIM_SF_KEY2 );
+    rtc3_setFrequencyCalibration( 1 );
+    CHECK( rtc3sim_peek( _RTC3_REG_SFR ) == 0x01 );
+
+    rtc3_setSpecialFunctionKey1( _RTC3SIM_SF_KEY1 );
+    rtc3_setSpecialFunctionKey2( _RTC3SIM_SF_KEY2 );
+    rtc3_setFrequencyCalibration( 0 );
+    CHECK( rtc3sim_peek( _RTC3_REG_SFR ) == 0x00 );
+
+    // The key is spent by one SFR write
+    rtc3_writeByte( _RTC3_REG_SFR, 0x01 );
+    CHECK( rtc3sim_peek( _RTC3_REG_SFR ) == 0x00 );
+}
+
+static void _testStopOf()
+{
+    _init();
+
+    // Power-on state has OF set, writing 0 clears it
+    CHECK( ( rtc3sim_peek( _RTC3_REG_TIME_MIN ) & 0x80 ) != 0 );
+    _set( 2024, 6, 1, 6, 12, 0, 0 );
+    CHECK( ( rtc3sim_peek( _RTC3_REG_TIME_MIN ) & 0x80 ) == 0 );
+
+    rtc3sim_failOscillator();
+    CHECK( ( rtc3sim_peek( _RTC3_REG_TIME_MIN ) & 0x80 ) != 0 );
+    CHECK( ( rtc3_readByte( _RTC3_REG_TIME_MIN ) & 0x80 ) != 0 );
+
+    // STOP holds the clock
+    _set( 2024, 6, 1, 6, 12, 0, 0 );
+    rtc3_disableCounting();
+    CHECK( ( rtc3sim_peek( _RTC3_REG_TIME_SEC ) & 0x80 ) != 0 );
+    rtc3sim_advance( 5 * _NS_PER_SECOND );
+    CHECK( ( rtc3sim_peek( _RTC3_REG_TIME_SEC ) & 0x7F ) == 0x00 );
+
+    rtc3_enableCounting();
+    CHECK( ( rtc3sim_peek( _RTC3_REG_TIME_SEC ) & 0x80 ) == 0 );
+    rtc3sim_advance( 5 * _NS_PER_SECOND );
+    CHECK( rtc3sim_peek( _RTC3_REG_TIME_SEC ) == 0x05 );
+}
+
+static void _testCalibration()
+{
+    // 10000.5 sec from a seconds write, so no read sits on a rollover
+    _init();
+    _set( 2024, 1, 1, 1, 0, 0, 0 );
+    rtc3sim_advance( 10000 * _NS_PER_SECOND + _NS_PER_SECOND / 2 );
+    CHECK( _is( 24, 1, 1, 1, 2, 46, 40 ) );
+
+    // +100 ppm gains one second
+    _init();
+    rtc3sim_setCrystalError( 100000 );
+    _set( 2024, 1, 1, 1, 0, 0, 0 );
+    rtc3sim_advance( 10000 * _NS_PER_SECOND + _NS_PER_SECOND / 2 );
+    CHECK( _is( 24, 1, 1, 1, 2, 46, 41 ) );
+
+    // Negative CAL 25 / 245760 takes it back to -1.7 ppm
+    _init();
+    rtc3sim_setCrystalError( 100000 );
+    rtc3_setCalibration( 1, 25 );
+    _set( 2024, 1, 1, 1, 0, 0, 0 );
+    rtc3sim_advance( 10000 * _NS_PER_SECOND + _NS_PER_SECOND / 2 );
+    CHECK( _is( 24, 1, 1, 1, 2, 46, 40 ) );
+
+    // -50 ppm loses one second in 20000, positive CAL 25 / 491520 cancels it
+    _init();
+    rtc3sim_setCrystalError( -50000 );
+    _set( 2024, 1, 1, 1, 0, 0, 0 );
+    rtc3sim_advance( 20000 * _NS_PER_SECOND + _NS_PER_SECOND / 2 );
+    CHECK( _is( 24, 1, 1, 1, 5, 33, 19 ) );
+
+    _init();
+    rtc3sim_setCrystalError( -50000 );
+    rtc3_setCalibration( 0, 25 );
+    _set( 2024, 1, 1, 1, 0, 0, 0 );
+    rtc3sim_advance( 20000 * _NS_PER_SECOND + _NS_PER_SECOND / 2 );
+    CHECK( _is( 24, 1, 1, 1, 5, 33, 20 ) );
+}
+
+static void _testRollover()
+{
+    _init();
+
+    // Minute, hour, day and weekday
+    _set( 2024, 6, 1, 7, 23, 59, 59 );
+    rtc3sim_advance( _NS_PER_SECOND );
+    CHECK( _is( 24, 6, 2, 1, 0, 0, 0 ) );
+
+    // 30 day month
+    _set( 2024, 4, 30, 2, 23, 59, 59 );
+    rtc3sim_advance( _NS_PER_SECOND );
+    CHECK( _is( 24, 5, 1, 3, 0, 0, 0 ) );
+
+    // Leap year February
+    _set( 2024, 2, 28, 3, 23, 59, 59 );
+    rtc3sim_advance( _NS_PER_SECOND );
+    CHECK( _is( 24, 2, 29, 4, 0, 0, 0 ) );
+    rtc3sim_advance( 86400 * _NS_PER_SECOND );
+    CHECK( _is( 24, 3, 1, 5, 0, 0, 0 ) );
+
+    // Common year February
+    _set( 2023, 2, 28, 2, 23, 59, 59 );
+    rtc3sim_advance( _NS_PER_SECOND );
+    CHECK( _is( 23, 3, 1, 3, 0, 0, 0 ) );
+
+    // Year end
+    _set( 2023, 12, 31, 7, 23, 59, 59 );
+    rtc3sim_advance( _NS_PER_SECOND );
+    CHECK( _is( 24, 1, 1, 1, 0, 0, 0 ) );
+
+    // Century, the year register wraps to 00
+    _set( 2099, 12, 31, 4, 23, 59, 59 );
+    rtc3sim_advance( _NS_PER_SECOND );
+    CHECK( _is( 0, 1, 1, 5, 0, 0, 0 ) );
+}
+
+/* --------------------------------------------------------------------- MAIN */
+
+static void _testNack()
+{
+    rtc3_t  absent;
+    uint8_t config1;
+    uint8_t value;
+
+    // No chip answers at 0x69, every transfer reports it
+    _init();
+    rtc3_ctxI2cDriverInit( &absent, (T_RTC3_P)&_HOST_MIKROBUS_GPIO, (T_RTC3_P)&_HOST_MIKROBUS_I2C, 0x69 );
+    config1 = absent.shadowConfig1;
+    value = 0x25;
+
+    CHECK( rtc3_ctxWriteBlock( &absent, _RTC3_REG_CONFIG1, &value, 1 ) == 1 );
+    CHECK( absent.shadowConfig1 == config1 );
+    CHECK( rtc3_ctxReadBlock( &absent, _RTC3_REG_TIME_SEC, &value, 1 ) == 1 );
+
+    // The bus was released, the chip still answers at its address
+    value = 0x25;
+    CHECK( rtc3_writeBlock( _RTC3_REG_CONFIG1, &value, 1 ) == 0 );
+    CHECK( rtc3sim_peek( _RTC3_REG_CONFIG1 ) == 0x25 );
+    CHECK( rtc3_readBlock( _RTC3_REG_CONFIG1, &value, 1 ) == 0 );
+}
+
+int main()
+{
+    _testBurst();
+    _testSfKeys();
+    _testStopOf();
+    _testCalibration();
+    _testRollover();
+    _testNack();
+
+    return CHECK_DONE();
+}
+
+                                                                       /** @} */
+/* -------------------------------------------------------------------------- */
+/*
+  test_sim.c
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+3. All advertising materials mentioning features or use of this software
+   must display the following acknowledgement:
+   This product includes software developed by the MikroElektonika.
+
+4. Neither the name of the MikroElektonika nor the
+   names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY MIKROELEKTRONIKA ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL MIKROELEKTRONIKA BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------------- */
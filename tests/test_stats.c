@@ -0,0 +1,173 @@
+/*
+    test_stats.c
+
+-----------------------------------------------------------------------------
+
+  This file is part of mikroSDK.
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+----------------------------------------------------------------------------- */
+
+/**
+@file   test_stats.c
+@brief    RTC 3 Click bus statistics against the BQ32000 simulator
+*/
+/**
+@defgroup   RTC3_TEST_STATS
+@brief      Per transaction and per call accounting with __HAL_STATS__
+@{
+
+    make -C tests check
+
+*/
+/* -------------------------------------------------------------------------- */
+
+#include "__rtc3_driver.h"
+#include "__rtc3_sim.h"
+#include "rtc3_check.h"
+
+/* ----------------------------------------------------------- PRIVATE FUNCTIONS */
+
+// Simulated time, in ns, moves only while the master is on the bus
+static uint32_t _clock()
+{
+    return (uint32_t)rtc3sim_getTime();
+}
+
+static void _init()
+{
+    rtc3sim_reset();
+    rtc3_i2cDriverInit( (T_RTC3_P)&_HOST_MIKROBUS_GPIO, (T_RTC3_P)&_HOST_MIKROBUS_I2C, _RTC3_I2C_ADDRESS );
+    rtc3_setStatsClock( _clock );
+    rtc3_resetStats();
+}
+
+/* -------------------------------------------------------------------- TESTS */
+
+static void _testTransaction()
+{
+    rtc3_stats_t stats;
+    uint8_t hours;
+    uint8_t minutes;
+    uint8_t seconds;
+
+    _init();
+    rtc3_getTime( &hours, &minutes, &seconds );
+    rtc3_getStats( &stats );
+
+    // Address, pointer, address again and three data bytes
+    CHECK( stats.starts == 1 );
+    CHECK( stats.restarts == 1 );
+    CHECK( stats.stops == 1 );
+    CHECK( stats.bytesWritten == 3 );
+    CHECK( stats.bytesRead == 3 );
+    CHECK( stats.errors == 0 );
+    CHECK( stats.transactions == 1 );
+    CHECK( stats.lastCycles > 0 );
+    CHECK( stats.calls == 1 );
+    CHECK( stats.lastCallTransactions == 1 );
+    CHECK( stats.lastCallCycles == stats.lastCycles );
+}
+
+static void _testCalls()
+{
+    rtc3_stats_t stats;
+
+    _init();
+    rtc3_enableCounting();
+    rtc3_getStats( &stats );
+    CHECK( stats.calls == 1 );
+    CHECK( stats.transactions == 2 );
+    CHECK( stats.lastCallTransactions == 2 );
+    CHECK( stats.lastCallCycles == stats.cycles );
+
+    rtc3_syncShadow();
+    rtc3_getStats( &stats );
+    CHECK( stats.calls == 2 );
+    CHECK( stats.lastCallTransactions == 2 );
+
+    // Both SF keys, the SFR and CONFIG1
+    rtc3_enableCalibrationOutput( 1 );
+    rtc3_getStats( &stats );
+    CHECK( stats.calls == 3 );
+    CHECK( stats.transactions == 8 );
+    CHECK( stats.lastCallTransactions == 4 );
+    CHECK( stats.maxCallTransactions == 4 );
+    CHECK( stats.callCycles == stats.cycles );
+    CHECK( stats.maxCallCycles >= stats.lastCallCycles );
+
+    rtc3_resetStats();
+    rtc3_getStats( &stats );
+    CHECK( stats.calls == 0 );
+    CHECK( stats.callCycles == 0 );
+    CHECK( stats.maxCallTransactions == 0 );
+}
+
+static void _testNoBus()
+{
+    rtc3_stats_t stats;
+    rtc3_datetime_t dateTime;
+
+    _init();
+
+    // Calls that stay off the bus are not counted
+    rtc3_epochToDateTime( 946684800UL, &dateTime );
+    rtc3_clockStop();
+    rtc3_getStats( &stats );
+    CHECK( stats.calls == 0 );
+    CHECK( stats.transactions == 0 );
+}
+
+/* --------------------------------------------------------------------- MAIN */
+
+int main()
+{
+    _testTransaction();
+    _testCalls();
+    _testNoBus();
+
+    return CHECK_DONE();
+}
+
+                                                                       /** @} */
+/* -------------------------------------------------------------------------- */
+/*
+  test_stats.c
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+3. All advertising materials mentioning features or use of this software
+   must display the following acknowledgement:
+   This product includes software developed by the MikroElektonika.
+
+4. Neither the name of the MikroElektonika nor the
+   names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY MIKROELEKTRONIKA ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL MIKROELEKTRONIKA BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------------- */
@@ -0,0 +1,289 @@
+/*
+    test_subsec.c
+
+-----------------------------------------------------------------------------
+
+  This file is part of mikroSDK.
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+----------------------------------------------------------------------------- */
+
+/**
+@file   test_subsec.c
+@brief    RTC 3 Click sub-second clock against the BQ32000 simulator
+*/
+/**
+@defgroup   RTC3_TEST_SUBSEC
+@brief      rtc3_subsecStart lock, 1/512 sec fraction, re-lock and timeout
+@{
+
+The edge counter samples the simulated INT pin and counts its rising
+edges. Time only moves in short steps between samples, and the bus
+reads at 400 kHz are shorter than the high half of a 512 Hz period,
+so no edge is missed.
+
+    make -C tests check
+
+*/
+/* -------------------------------------------------------------------------- */
+
+#include "__rtc3_driver.h"
+#include "__rtc3_sim.h"
+#include "rtc3_check.h"
+
+/* ------------------------------------------------------------------- MACROS */
+
+#define _NS_PER_SECOND                                                    1000000000ULL
+#define _STEP_NS                                                          20000UL
+
+/* ----------------------------------------------------------------- VARIABLES */
+
+static uint32_t _edges;
+static uint8_t  _pinLast;
+
+/* ----------------------------------------------------------- PRIVATE FUNCTIONS */
+
+static void _sample()
+{
+    uint8_t pin;
+
+    pin = rtc3sim_getIrq();
+
+    if ( ( pin != 0 ) && ( _pinLast == 0 ) )
+    {
+        _edges++;
+    }
+
+    _pinLast = pin;
+}
+
+// Timer clocked by INT, every read lets 20 us of simulated time pass
+static uint32_t _counter()
+{
+    _sample();
+    rtc3sim_advance( _STEP_NS );
+    _sample();
+
+    return _edges;
+}
+
+static uint32_t _stuck()
+{
+    return 7;
+}
+
+static void _advance( uint64_t nanoseconds )
+{
+    while ( nanoseconds >= _STEP_NS )
+    {
+        _counter();
+        nanoseconds -= _STEP_NS;
+    }
+}
+
+static void _init()
+{
+    rtc3_datetime_t dateTime;
+
+    rtc3sim_reset();
+    rtc3sim_setBusTiming( 400000UL, 0 );
+    rtc3_i2cDriverInit( (T_RTC3_P)&_HOST_MIKROBUS_GPIO, (T_RTC3_P)&_HOST_MIKROBUS_I2C, _RTC3_I2C_ADDRESS );
+    rtc3_syncShadow();
+
+    dateTime.timeSeconds = 10;
+    dateTime.timeMinutes = 20;
+    dateTime.timeHours = 12;
+    dateTime.dayOfTheWeek = 3;
+    dateTime.dateDay = 15;
+    dateTime.dateMonth = 5;
+    dateTime.dateYear = 24;
+
+    rtc3_setDateTime( &dateTime );
+    rtc3sim_advance( _NS_PER_SECOND / 3 );
+
+    _edges = 0;
+    _pinLast = rtc3sim_getIrq();
+}
+
+// Sub-second clock minus the chip, in 1/512 sec, on the next chip rollover
+static int32_t _errorAtRollover( uint8_t service )
+{
+    uint16_t fraction;
+    uint32_t epoch;
+    uint8_t  seconds;
+
+    seconds = rtc3_getTimeSeconds();
+
+    while ( rtc3_getTimeSeconds() == seconds )
+    {
+        _advance( 100000UL );
+
+        if ( service )
+        {
+            rtc3_subsecService();
+        }
+    }
+
+    epoch = rtc3_subsecGet( &fraction );
+
+    return ( int32_t )( epoch - rtc3_getEpoch() ) * 512 + fraction;
+}
+
+/* -------------------------------------------------------------------- TESTS */
+
+static void _testLock()
+{
+    uint64_t start;
+    int32_t  error;
+
+    _init();
+    start = rtc3sim_getTime();
+
+    CHECK( rtc3_subsecStart( _counter, 0 ) == 0 );
+    CHECK( rtc3sim_getTime() - start < 2 * _NS_PER_SECOND );
+
+    // Locked on the rollover the chip just made
+    error = _errorAtRollover( 0 );
+    CHECK( ( error >= -1 ) && ( error <= 1 ) );
+}
+
+static void _testFraction()
+{
+    uint8_t  seen[ 512 ];
+    uint16_t fraction;
+    uint16_t distinct;
+    uint16_t cnt;
+    uint32_t epoch;
+    uint32_t first;
+
+    _init();
+    CHECK( rtc3_subsecStart( _counter, 0 ) == 0 );
+
+    for ( cnt = 0; cnt < 512; cnt++ )
+    {
+        seen[ cnt ] = 0;
+    }
+
+    first = rtc3_subsecGet( &fraction );
+    while ( rtc3_subsecGet( &fraction ) == first )
+    {
+        _counter();
+    }
+
+    // One whole second goes through every 1/512 step once
+    first++;
+    distinct = 0;
+
+    while ( ( epoch = rtc3_subsecGet( &fraction ) ) == first )
+    {
+        if ( seen[ fraction ] == 0 )
+        {
+            seen[ fraction ] = 1;
+            distinct++;
+        }
+
+        _counter();
+    }
+
+    CHECK( distinct == 512 );
+    CHECK( epoch == first + 1 && fraction == 0 );
+}
+
+static void _testRelock()
+{
+    int32_t  freeRun;
+    int32_t  tracked;
+    uint32_t relocks;
+    uint32_t cnt;
+
+    // CAL at -126 ppm moves the seconds, the 512 Hz output keeps its rate
+    _init();
+    rtc3_setCalibration( 1, 31 );
+    CHECK( rtc3_subsecStart( _counter, 0 ) == 0 );
+    _advance( 60 * _NS_PER_SECOND );
+    freeRun = _errorAtRollover( 0 );
+    CHECK( freeRun >= 3 );
+
+    _init();
+    rtc3_setCalibration( 1, 31 );
+    CHECK( rtc3_subsecStart( _counter, 8 ) == 0 );
+    relocks = 0;
+
+    for ( cnt = 0; cnt < 60000; cnt++ )
+    {
+        _advance( 1000000UL );
+        relocks += rtc3_subsecService();
+    }
+
+    tracked = _errorAtRollover( 1 );
+    CHECK( relocks >= 6 );
+    CHECK( ( tracked >= -1 ) && ( tracked <= 1 ) );
+}
+
+static void _testTimeout()
+{
+    uint16_t fraction;
+
+    // Counter stuck, or no interrupt counting edges
+    _init();
+    CHECK( rtc3_subsecStart( _stuck, 0 ) == 1 );
+    CHECK( rtc3_subsecGet( &fraction ) == 0 );
+
+    _init();
+    CHECK( rtc3_subsecStart( 0, 0 ) == 1 );
+}
+
+/* --------------------------------------------------------------------- MAIN */
+
+int main()
+{
+    _testLock();
+    _testFraction();
+    _testRelock();
+    _testTimeout();
+
+    return CHECK_DONE();
+}
+
+                                                                       /** @} */
+/* -------------------------------------------------------------------------- */
+/*
+  test_subsec.c
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+3. All advertising materials mentioning features or use of this software
+   must display the following acknowledgement:
+   This product includes software developed by the MikroElektonika.
+
+4. Neither the name of the MikroElektonika nor the
+   names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY MIKROELEKTRONIKA ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL MIKROELEKTRONIKA BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------------- */
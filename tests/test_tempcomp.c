@@ -0,0 +1,213 @@
+/*
+    test_tempcomp.c
+
+-----------------------------------------------------------------------------
+
+  This file is part of mikroSDK.
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+----------------------------------------------------------------------------- */
+
+/**
+@file   test_tempcomp.c
+@brief    RTC 3 Click temperature compensation accuracy per day
+*/
+/**
+@defgroup   RTC3_TEST_TEMPCOMP
+@brief      One simulated day per temperature, with and without rtc3_tempCompService
+@{
+
+The crystal runs 12 ppm fast at its turnover and drifts parabolically
+with temperature. Each case sets the clock, runs one simulated day calling
+rtc3_tempCompService every second, then finds the next seconds rollover
+to the millisecond and compares it with the simulated time. The error per
+day of every case is printed before the summary.
+
+    make -C tests check
+
+*/
+/* -------------------------------------------------------------------------- */
+
+#include <stdio.h>
+
+#include "__rtc3_driver.h"
+#include "__rtc3_sim.h"
+#include "rtc3_check.h"
+
+/* ------------------------------------------------------------------- MACROS */
+
+#define _NS_PER_SECOND                                                    1000000000ULL
+#define _NS_PER_MS                                                        1000000ULL
+#define _SECONDS_PER_DAY                                                  86400UL
+#define _CRYSTAL_PPB                                                      12000L
+
+// Half of the coarser CAL step, 2.03 ppm, is 176 ms per day
+#define _COMPENSATED_MS_MAX                                               200
+
+/* ---------------------------------------------------------------- VARIABLES */
+
+static int16_t _temperature;
+
+/* ----------------------------------------------------------- PRIVATE FUNCTIONS */
+
+static int16_t _readTemperature()
+{
+    return _temperature;
+}
+
+// Simulated temperature, a constant or a 5 C - 35 C swing over the day
+static void _setTemperature( int16_t base, uint8_t swing, uint32_t second )
+{
+    int32_t phase;
+
+    _temperature = base;
+
+    if ( swing )
+    {
+        // Triangle, coldest at midnight, warmest at noon
+        phase = ( second < _SECONDS_PER_DAY / 2 ) ? second : _SECONDS_PER_DAY - second;
+        _temperature = 50 + ( int16_t )( phase * 300 / ( _SECONDS_PER_DAY / 2 ) );
+    }
+
+    rtc3sim_setTemperature( _temperature );
+}
+
+static uint32_t _peekEpoch()
+{
+    rtc3_snapshot_t snapshot;
+    rtc3_datetime_t dateTime;
+    uint8_t cnt;
+
+    for ( cnt = 0; cnt < 7; cnt++ )
+    {
+        snapshot.reg[ cnt ] = rtc3sim_peek( cnt );
+    }
+
+    rtc3_decodeSnapshot( &snapshot, &dateTime );
+
+    return rtc3_dateTimeToEpoch( &dateTime );
+}
+
+// Clock error after one day in ms, positive runs fast
+static int32_t _day( int16_t base, uint8_t swing, uint8_t compensate )
+{
+    uint64_t start;
+    uint32_t epoch;
+    uint32_t second;
+
+    rtc3sim_reset();
+    rtc3_i2cDriverInit( (T_RTC3_P)&_HOST_MIKROBUS_GPIO, (T_RTC3_P)&_HOST_MIKROBUS_I2C, _RTC3_I2C_ADDRESS );
+    rtc3sim_setCrystalError( _CRYSTAL_PPB );
+    _setTemperature( base, swing, 0 );
+
+    rtc3_tempCompInit( compensate ? _readTemperature : 0, _CRYSTAL_PPB, 60 );
+    rtc3_tempCompService();
+
+    // The seconds write restarts the divider chain
+    rtc3_setEpoch( 1704067200UL );
+    start = rtc3sim_getTime();
+
+    for ( second = 1; second < _SECONDS_PER_DAY; second++ )
+    {
+        rtc3sim_advance( start + second * _NS_PER_SECOND - rtc3sim_getTime() );
+        _setTemperature( base, swing, second );
+        rtc3_tempCompService();
+    }
+
+    // Rollovers within the last seconds of the day, to the ms
+    epoch = _peekEpoch();
+
+    while ( _peekEpoch() == epoch )
+    {
+        rtc3sim_advance( _NS_PER_MS );
+    }
+
+    return ( int32_t )( ( uint64_t )( _peekEpoch() - 1704067200UL ) * 1000 ) -
+           ( int32_t )( ( rtc3sim_getTime() - start ) / _NS_PER_MS );
+}
+
+/* -------------------------------------------------------------------- TESTS */
+
+static void _testAccuracy()
+{
+    static const int16_t base[] = { -100, 0, 250, 450, 700 };
+    int32_t plain;
+    int32_t compensated;
+    uint8_t cnt;
+
+    printf( "temperature_c,plain_ms_per_day,compensated_ms_per_day\n" );
+
+    for ( cnt = 0; cnt <= sizeof( base ) / sizeof( base[ 0 ] ); cnt++ )
+    {
+        if ( cnt < sizeof( base ) / sizeof( base[ 0 ] ) )
+        {
+            plain = _day( base[ cnt ], 0, 0 );
+            compensated = _day( base[ cnt ], 0, 1 );
+            printf( "%.1f,%d,%d\n", base[ cnt ] / 10.0, plain, compensated );
+        }
+        else
+        {
+            plain = _day( 0, 1, 0 );
+            compensated = _day( 0, 1, 1 );
+            printf( "5-35,%d,%d\n", plain, compensated );
+        }
+
+        CHECK( ( compensated < _COMPENSATED_MS_MAX ) && ( compensated > -_COMPENSATED_MS_MAX ) );
+    }
+
+    // Away from the turnover the uncompensated crystal is well off
+    CHECK( _day( -100, 0, 0 ) < -2000 );
+    CHECK( _day( 250, 0, 0 ) > 1000 );
+}
+
+/* --------------------------------------------------------------------- MAIN */
+
+int main()
+{
+    _testAccuracy();
+
+    return CHECK_DONE();
+}
+
+                                                                       /** @} */
+/* -------------------------------------------------------------------------- */
+/*
+  test_tempcomp.c
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+3. All advertising materials mentioning features or use of this software
+   must display the following acknowledgement:
+   This product includes software developed by the MikroElektonika.
+
+4. Neither the name of the MikroElektonika nor the
+   names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY MIKROELEKTRONIKA ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL MIKROELEKTRONIKA BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------------- */